@@ -624,8 +624,11 @@ Rule::Rule(const string &g,uint4 fl,const string &nm)
   name = nm;
   breakpoint = 0;
   basegroup = g;
+  filter = 0;
+  filter_def = CPUI_MAX;
   count_tests = 0;
   count_apply = 0;
+  count_filtered = 0;
 }
 
 /// This method is called whenever \b this Rule applies. If warnings have been
@@ -658,6 +661,7 @@ void Rule::resetStats(void)
 {
   count_tests = 0;
   count_apply = 0;
+  count_filtered = 0;
 }
 
 #ifdef OPACTION_DEBUG
@@ -695,7 +699,37 @@ bool Rule::turnOffDebug(const string &nm)
 void Rule::printStatistics(ostream &s) const
 
 {
-  s << name << dec << " Tested=" << count_tests << " Applied=" << count_apply << endl;
+  s << name << dec << " Tested=" << count_tests << " Applied=" << count_apply;
+  s << " Filtered=" << count_filtered << endl;
+}
+
+/// The properties are computed once for the PcodeOp and can be checked against the
+/// preconditions of every Rule that might apply to it.
+/// \param op is the given PcodeOp
+/// \param defopc will hold the op-code of the PcodeOp defining input 0, or CPUI_MAX
+/// \return the set of filterflags properties of the PcodeOp
+uint4 Rule::opShape(PcodeOp *op,OpCode &defopc)
+
+{
+  uint4 shape = 0;
+  defopc = CPUI_MAX;
+  if (op->numInput() > 0) {
+    Varnode *vn = op->getIn(0);
+    if (vn->isWritten()) {
+      shape |= in0_written;
+      defopc = vn->getDef()->code();
+    }
+    else if (vn->isConstant())
+      shape |= in0_constant;
+  }
+  if (op->numInput() > 1) {
+    Varnode *vn = op->getIn(1);
+    if (vn->isWritten())
+      shape |= in1_written;
+    else if (vn->isConstant())
+      shape |= in1_constant;
+  }
+  return shape;
 }
 
 /// Populate the given array with all possible OpCodes this Rule might apply to.
@@ -823,6 +857,8 @@ int4 ActionPool::processOp(PcodeOp *op,Funcdata &data)
   Rule *rl;
   int4 res;
   uint4 opc;
+  uint4 shape;
+  OpCode defopc;
 
   if (op->isDead()) {
     op_state++;
@@ -831,9 +867,22 @@ int4 ActionPool::processOp(PcodeOp *op,Funcdata &data)
     return 0;
   }
   opc = op->code();
+  if (rule_index == 0) {
+    if (!fullpass && !op->isRevisit()) {	// Nothing around this op changed since it was last examined
+      count_skips += perop[opc].size();
+      op_state++;
+      return 0;
+    }
+    data.opClearRevisit(op);
+  }
+  shape = Rule::opShape(op,defopc);	// Computed once for all Rule filters
   while(rule_index < perop[opc].size()) {
     rl = perop[opc][rule_index++];
     if (rl->isDisabled()) continue;
+    if (!rl->passFilter(shape,defopc)) {
+      rl->count_filtered += 1;
+      continue;
+    }
 #ifdef OPACTION_DEBUG
     data.debugActivate();
 #endif
@@ -859,11 +908,13 @@ int4 ActionPool::processOp(PcodeOp *op,Funcdata &data)
         opc = op->code();
         rule_index = 0;		
       }
+      shape = Rule::opShape(op,defopc);	// Rule may have changed the op's inputs
     }
     else if (opc != op->code()) {
       data.getArch()->printMessage("ERROR: Rule " + rl->getName() + " changed op without returning result of 1!");
       opc = op->code();
       rule_index = 0;	
+      shape = Rule::opShape(op,defopc);
     }
   }
   op_state++;
@@ -872,15 +923,27 @@ int4 ActionPool::processOp(PcodeOp *op,Funcdata &data)
   return 0;
 }
 
+/// The first pass over the function examines every PcodeOp.  If the \e partialrulepasses option
+/// is on, each repeat pass only examines PcodeOps that have been marked for a revisit, because
+/// they or their immediate neighbors were modified since they were last examined.  If a partial
+/// pass makes no change, a final full pass is made, so the pool stops at the same kind of fixed
+/// point as when every pass is a full pass.
 int4 ActionPool::apply(Funcdata &data)
 
 {
   if (status != status_mid) {
     op_state = data.beginOpAll();	// Initialize the derived action
     rule_index = 0;
+    fullpass = (status != status_repeat || !data.getArch()->partial_rule_passes);
+  }
+  for(;;) {
+    for(;op_state!=data.endOpAll();)
+      if (0!=processOp((*op_state).second,data)) return -1;
+    if (fullpass || lcount < count) break;
+    fullpass = true;		// Partial pass made no change, confirm with a full pass
+    op_state = data.beginOpAll();
+    rule_index = 0;
   }
-  for(;op_state!=data.endOpAll();)
-	  if (0!=processOp((*op_state).second,data)) return -1;
 
   return 0;			// Indicate successful completion
 }
@@ -927,6 +990,7 @@ void ActionPool::resetStats(void)
   vector<Rule *>::iterator iter;
 
   Action::resetStats();
+  count_skips = 0;
   for(iter=allrules.begin();iter!=allrules.end();++iter)
     (*iter)->resetStats();
 }
@@ -964,7 +1028,8 @@ void ActionPool::printStatistics(ostream &s) const
 {
   vector<Rule *>::const_iterator iter;
 
-  Action::printStatistics(s);
+  s << getName() << dec << " Tested=" << count_tests << " Applied=" << count_apply;
+  s << " Skipped=" << count_skips << endl;
   for(iter=allrules.begin();iter!=allrules.end();++iter)
     (*iter)->printStatistics(s);
 }
@@ -191,6 +191,10 @@ public:
 /// A Rule supports the same breakpoint properties as an Action.
 /// A Rule is allowed to keep state that is specific to a given function (Funcdata).
 /// The reset() method is invoked to purge this state for each new function to be transformed.
+///
+/// A Rule can also declare simple structural preconditions on the PcodeOp, via setFilter(),
+/// that must hold before applyOp() can possibly succeed. The ActionPool computes the
+/// shape of each PcodeOp once and rejects Rules whose preconditions fail without calling applyOp().
 class Rule {
 public:
   /// Properties associated with a Rule
@@ -200,15 +204,35 @@ public:
     warnings_on = 4,		///< A warning is issued if this rule is applied
     warnings_given = 8		///< Set if a warning for this rule has been given before
   };
+  /// Structural properties of a PcodeOp that a Rule can require
+  enum filterflags {
+    in0_written = 1,		///< Input 0 is defined by a PcodeOp
+    in0_constant = 2,		///< Input 0 is a constant
+    in1_written = 4,		///< Input 1 is defined by a PcodeOp
+    in1_constant = 8		///< Input 1 is a constant
+  };
 private:
   friend class ActionPool;
   uint4 flags;			///< Properties enabled with \b this Rule
   uint4 breakpoint;		///< Breakpoint(s) enabled for \b this Rule
   string name;			///< Name of the Rule
   string basegroup;		///< Group to which \b this Rule belongs
+  uint4 filter;			///< Properties (filterflags) a PcodeOp must have for \b this Rule to apply
+  OpCode filter_def;		///< Op-code that must define input 0 (or CPUI_MAX for any)
   uint4 count_tests;		///< Number of times \b this Rule has attempted to apply
   uint4 count_apply;		///< Number of times \b this Rule has successfully been applied
+  uint4 count_filtered;		///< Number of times \b this Rule was rejected by its filter
   void issueWarning(Architecture *glb);	///< If enabled, print a warning that this Rule has been applied
+  /// \brief Check a PcodeOp shape against the preconditions of \b this Rule
+  ///
+  /// \param shape is the set of filterflags properties of the PcodeOp
+  /// \param defopc is the op-code defining input 0 of the PcodeOp (or CPUI_MAX)
+  /// \return \b true if applyOp() should be called
+  bool passFilter(uint4 shape,OpCode defopc) const {
+    return ((shape & filter) == filter) && (filter_def == CPUI_MAX || filter_def == defopc); }
+  static uint4 opShape(PcodeOp *op,OpCode &defopc);	///< Compute the filter properties of a PcodeOp
+protected:
+  void setFilter(uint4 fl,OpCode def=CPUI_MAX) { filter = fl; filter_def = def; }	///< Set preconditions for \b this Rule
 public:
   Rule(const string &g,uint4 fl,const string &nm);		///< Construct given group, properties name
   virtual ~Rule(void) {}					///< Destructor
@@ -216,6 +240,7 @@ public:
   const string &getGroup(void) const { return basegroup; }	///< Return the group \b this Rule belongs to
   uint4 getNumTests(void) { return count_tests; }		///< Get number of attempted applications
   uint4 getNumApply(void) { return count_apply; }		///< Get number of successful applications
+  uint4 getNumFiltered(void) { return count_filtered; }		///< Get number of applications rejected by the filter
   void setBreak(uint4 tp) { breakpoint |= tp; }			///< Set a breakpoint on \b this Rule
   void clearBreak(uint4 tp) { breakpoint &= ~tp; }		///< Clear a breakpoint on \b this Rule
   void clearBreakPoints(void) { breakpoint = 0; }		///< Clear all breakpoints on \b this Rule
@@ -264,9 +289,11 @@ class ActionPool : public Action {
   vector<Rule *> perop[CPUI_MAX];			///< Rules associated with each OpCode
   PcodeOpTree::const_iterator op_state; 		///< Current PcodeOp up for rule application
   int4 rule_index;					///< Iterator over Rules for one OpCode
+  bool fullpass;					///< \b true if the current pass examines every PcodeOp
+  uint4 count_skips;					///< Number of Rule tests avoided by partial passes
   int4 processOp(PcodeOp *op,Funcdata &data);		///< Apply the next possible Rule to a PcodeOp
 public:
-  ActionPool(uint4 f,const string &nm) : Action(f,nm,"") {}	///< Construct providing properties and name
+  ActionPool(uint4 f,const string &nm) : Action(f,nm,"") { fullpass = true; count_skips = 0; }	///< Construct providing properties and name
   virtual ~ActionPool(void);				///< Destructor
   void addRule(Rule *rl);				///< Add a Rule to the pool
   virtual void clearBreakPoints(void);
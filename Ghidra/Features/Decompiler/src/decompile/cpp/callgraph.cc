@@ -351,6 +351,58 @@ CallGraphNode *CallGraph::nextLeaf(CallGraphNode *node)
   return node;
 }
 
+int4 CallGraph::buildLevels(vector<vector<CallGraphNode *> > &levels)
+
+{ // Sort all nodes into dependency levels, with snipped cycle edges ignored.
+  // Level 0 holds the leaves. Every callee of a node in level i is in a level below i,
+  // so the nodes within a single level do not depend on each other.
+  cycleStructure();
+  levels.clear();
+  map<CallGraphNode *,int4> remain;	// Number of callees not yet placed in a level
+  vector<CallGraphNode *> cur;
+  map<Address,CallGraphNode>::iterator iter;
+
+  for(iter=graph.begin();iter!=graph.end();++iter) {
+    CallGraphNode *node = &(*iter).second;
+    int4 count = 0;
+    for(int4 i=0;i<node->outedge.size();++i) {
+      if ((node->outedge[i].flags & CallGraphEdge::cycle)==0)
+	count += 1;
+    }
+    if (count == 0)
+      cur.push_back(node);
+    else
+      remain[node] = count;
+  }
+  int4 placed = 0;
+  while(!cur.empty()) {
+    levels.push_back(cur);
+    placed += cur.size();
+    cur.clear();
+    const vector<CallGraphNode *> &last( levels.back() );
+    for(int4 i=0;i<last.size();++i) {
+      CallGraphNode *node = last[i];
+      for(int4 j=0;j<node->inedge.size();++j) {
+	if ((node->inedge[j].flags & CallGraphEdge::cycle)!=0) continue;
+	CallGraphNode *from = node->inedge[j].from;
+	int4 &count( remain[from] );
+	count -= 1;
+	if (count == 0)
+	  cur.push_back(from);
+      }
+    }
+  }
+  if (placed < graph.size()) {	// Should not happen after cycleStructure, but don't lose nodes
+    map<CallGraphNode *,int4>::iterator riter;
+    for(riter=remain.begin();riter!=remain.end();++riter) {
+      if ((*riter).second > 0)
+	cur.push_back((*riter).first);
+    }
+    levels.push_back(cur);
+  }
+  return levels.size();
+}
+
 void CallGraph::cycleStructure(void)
 
 { // Generate list of seeds nodes (from which we can get to everything)
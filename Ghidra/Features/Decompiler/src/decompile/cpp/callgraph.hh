@@ -112,6 +112,7 @@ public:
   void deleteInEdge(CallGraphNode *node,int4 i);
   CallGraphNode * initLeafWalk(void);
   CallGraphNode *nextLeaf(CallGraphNode *node);
+  int4 buildLevels(vector<vector<CallGraphNode *> > &levels);
   map<Address,CallGraphNode>::iterator begin(void) { return graph.begin(); }
   map<Address,CallGraphNode>::iterator end(void) { return graph.end(); }
   void buildAllNodes(void);
@@ -212,6 +212,74 @@ void CoverBlock::print(ostream &s) const
     s << stop->getSeqNum();
 }
 
+/// \brief Compare Cover entries by block index
+///
+/// \param a is the first entry
+/// \param b is the second entry
+/// \return \b true if the first entry's block comes before the second's
+static bool compareBlockIndex(const pair<int4,CoverBlock> &a,const pair<int4,CoverBlock> &b)
+
+{
+  return (a.first < b.first);
+}
+
+/// \brief Compare Cover entries by decreasing block index
+///
+/// \param a is the first entry
+/// \param b is the second entry
+/// \return \b true if the first entry's block comes after the second's
+static bool compareBlockIndexReverse(const pair<int4,CoverBlock> &a,const pair<int4,CoverBlock> &b)
+
+{
+  return (a.first > b.first);
+}
+
+/// \param blk is the index of the block to search for
+/// \return the entry for the block or the end iterator if \b this does not cover it
+Cover::BlockList::const_iterator Cover::findBlock(int4 blk) const
+
+{
+  BlockList::const_iterator iter = lower_bound(cover.begin(),cover.end(),pair<int4,CoverBlock>(blk,emptyBlock),
+					       compareBlockIndex);
+  if ((iter != cover.end())&&((*iter).first == blk))
+    return iter;
+  return cover.end();
+}
+
+/// While a read is being added, the list is in two parts: the entries that were present before,
+/// sorted by increasing block index, followed by the new entries, sorted by \e decreasing block index.
+/// Cover is filled in backward from the read, so blocks tend to be reached in decreasing order,
+/// and a new entry usually goes at the very end of the list.  sortNewBlocks() restores the
+/// sorted order once the read is added.  If there is no entry for the block, an empty CoverBlock
+/// is inserted.  The reference is invalidated by the next insertion.
+/// \param blk is the index of the block
+/// \param sorted is the number of entries in the increasing part of the list
+/// \return the (possibly new) CoverBlock for the block
+CoverBlock &Cover::getBlock(int4 blk,int4 sorted)
+
+{
+  pair<int4,CoverBlock> key(blk,emptyBlock);
+  BlockList::iterator enditer = cover.begin() + sorted;
+  BlockList::iterator iter = lower_bound(cover.begin(),enditer,key,compareBlockIndex);
+  if ((iter != enditer)&&((*iter).first == blk))
+    return (*iter).second;
+  iter = lower_bound(enditer,cover.end(),key,compareBlockIndexReverse);
+  if ((iter == cover.end())||((*iter).first != blk))
+    iter = cover.insert(iter,key);
+  return (*iter).second;
+}
+
+/// The entries added by getBlock() after the first \e sorted entries are put back in
+/// increasing order and merged with the rest of the list.
+/// \param sorted is the number of entries in the increasing part of the list
+void Cover::sortNewBlocks(int4 sorted)
+
+{
+  if (sorted == cover.size()) return;
+  reverse(cover.begin() + sorted,cover.end());
+  inplace_merge(cover.begin(),cover.begin() + sorted,cover.end(),compareBlockIndex);
+}
+
 /// Compare \b this with another Cover by comparing just
 /// the indices of the first blocks respectively that are partly covered.
 /// Return -1, 0, or 1 if \b this Cover's first block has a
@@ -223,7 +291,7 @@ int4 Cover::compareTo(const Cover &op2) const
 {
   int4 a,b;
 
-  map<int4,CoverBlock>::const_iterator iter;
+  BlockList::const_iterator iter;
   iter = cover.begin();
   if (iter==cover.end())
     a = 1000000;
@@ -251,7 +319,7 @@ int4 Cover::compareTo(const Cover &op2) const
 const CoverBlock &Cover::getCoverBlock(int4 i) const
 
 {
-  map<int4,CoverBlock>::const_iterator iter = cover.find(i);
+  BlockList::const_iterator iter = findBlock(i);
   if (iter == cover.end())
     return emptyBlock;
   return (*iter).second;
@@ -267,7 +335,7 @@ const CoverBlock &Cover::getCoverBlock(int4 i) const
 int4 Cover::intersect(const Cover &op2) const
 
 {
-  map<int4,CoverBlock>::const_iterator iter,iter2;
+  BlockList::const_iterator iter,iter2;
   int4 res,newres;
 
   res = 0;
@@ -305,7 +373,7 @@ int4 Cover::intersect(const Cover &op2) const
 void Cover::intersectList(vector<int4> &listout,const Cover &op2,int4 level) const
 
 {
-  map<int4,CoverBlock>::const_iterator iter,iter2;
+  BlockList::const_iterator iter,iter2;
   int4 val;
 
   listout.clear();
@@ -342,14 +410,14 @@ void Cover::intersectList(vector<int4> &listout,const Cover &op2,int4 level) con
 int4 Cover::intersectByBlock(int4 blk,const Cover &op2) const
 
 {
-  map<int4,CoverBlock>::const_iterator iter;
+  BlockList::const_iterator iter;
 
-  iter = cover.find(blk);
+  iter = findBlock(blk);
   if (iter == cover.end()) return 0;
   
-  map<int4,CoverBlock>::const_iterator iter2;
+  BlockList::const_iterator iter2;
 
-  iter2 = op2.cover.find(blk);
+  iter2 = op2.findBlock(blk);
   if (iter2 == op2.cover.end()) return 0;
 
   return (*iter).second.intersect((*iter2).second);
@@ -363,9 +431,9 @@ int4 Cover::intersectByBlock(int4 blk,const Cover &op2) const
 bool Cover::contain(const PcodeOp *op,int4 max) const
 
 {
-  map<int4,CoverBlock>::const_iterator iter;
+  BlockList::const_iterator iter;
 
-  iter = cover.find(op->getParent()->getIndex());
+  iter = findBlock(op->getParent()->getIndex());
   if (iter == cover.end()) return false;
   if ((*iter).second.contain(op)) {
     if (max==1) return true;
@@ -400,7 +468,7 @@ int4 Cover::containVarnodeDef(const Varnode *vn) const
   }
   else
     blk = op->getParent()->getIndex();
-  map<int4,CoverBlock>::const_iterator iter = cover.find(blk);
+  BlockList::const_iterator iter = findBlock(blk);
   if (iter == cover.end()) return 0;
   if ((*iter).second.contain(op)) {
     int4 boundtype = (*iter).second.boundary(op);
@@ -411,14 +479,41 @@ int4 Cover::containVarnodeDef(const Varnode *vn) const
   return 0;
 }
 
+/// Both lists are already sorted, so they are merged in a single pass.
 /// \param op2 is the other Cover
 void Cover::merge(const Cover &op2)
 
 {
-  map<int4,CoverBlock>::const_iterator iter;
-
-  for(iter=op2.cover.begin();iter!=op2.cover.end();++iter)
-    cover[(*iter).first].merge((*iter).second);
+  if (op2.cover.empty()) return;
+  if (cover.empty()) {
+    cover = op2.cover;
+    return;
+  }
+  BlockList res;
+  res.reserve(cover.size() + op2.cover.size());
+  BlockList::const_iterator iter = cover.begin();
+  BlockList::const_iterator enditer = cover.end();
+  BlockList::const_iterator iter2 = op2.cover.begin();
+  BlockList::const_iterator enditer2 = op2.cover.end();
+  while((iter != enditer)&&(iter2 != enditer2)) {
+    if ((*iter).first < (*iter2).first) {
+      res.push_back(*iter);
+      ++iter;
+    }
+    else if ((*iter).first > (*iter2).first) {
+      res.push_back(*iter2);
+      ++iter2;
+    }
+    else {
+      res.push_back(*iter);
+      res.back().second.merge((*iter2).second);
+      ++iter;
+      ++iter2;
+    }
+  }
+  res.insert(res.end(),iter,enditer);
+  res.insert(res.end(),iter2,enditer2);
+  cover.swap(res);
 }
 
 /// The cover is set to all p-code ops between the point where
@@ -446,12 +541,12 @@ void Cover::addDefPoint(const Varnode *vn)
 
   def = vn->getDef();
   if (def != (const PcodeOp *)0) {
-    CoverBlock &block( cover[def->getParent()->getIndex() ] );
+    CoverBlock &block( getBlock(def->getParent()->getIndex(),0) );
     block.setBegin(def);	// Set the point topology
     block.setEnd(def);
   }
   else if (vn->isInput()) {
-    CoverBlock &block( cover[0] );
+    CoverBlock &block( getBlock(0,0) );
     block.setBegin( (const PcodeOp *)2 ); // Special mark for input
     block.setEnd( (const PcodeOp *)2 );
   }
@@ -460,19 +555,19 @@ void Cover::addDefPoint(const Varnode *vn)
 /// Add to \b this Cover recursively, starting at bottom of the given block
 /// and filling in backward until we run into existing cover.
 /// \param bl is the starting block to add
-void Cover::addRefRecurse(const FlowBlock *bl)
+void Cover::addRefRecurse(const FlowBlock *bl,int4 sorted)
 
 {
   int4 j;
   uintm ustart,ustop;
 
-  CoverBlock &block(cover[bl->getIndex()]);
+  CoverBlock &block(getBlock(bl->getIndex(),sorted));
   if (block.empty()) {
     block.setAll();		// No cover encountered, fill in entire block
     //    if (bl->InSize()==0)
     //      throw LowlevelError("Ref point is not in flow of defpoint");
     for(j=0;j<bl->sizeIn();++j)	// Recurse to all blocks that fall into bl
-      addRefRecurse(bl->getIn(j));
+      addRefRecurse(bl->getIn(j),sorted);
   }
   else {
     const PcodeOp *op = block.getStop();
@@ -488,7 +583,7 @@ void Cover::addRefRecurse(const FlowBlock *bl)
 				// of cover through one branch of a MULTIEQUAL
 				// we still need to traverse through branches
 	for(j=0;j<bl->sizeIn();++j)
-	  addRefRecurse(bl->getIn(j));
+	  addRefRecurse(bl->getIn(j),sorted);
       }
     }
 
@@ -503,13 +598,26 @@ void Cover::addRefRecurse(const FlowBlock *bl)
 /// \param vn is the Varnode being read
 void Cover::addRefPoint(const PcodeOp *ref,const Varnode *vn)
 
+{
+  int4 sorted = cover.size();
+  addRefInternal(ref,vn,sorted);
+  sortNewBlocks(sorted);
+}
+
+/// This does the work of addRefPoint(), but leaves any new entries at the end of the list,
+/// in decreasing order, for the caller to merge in.
+/// \param ref is the reading PcodeOp
+/// \param vn is the Varnode being read
+/// \param sorted is the number of entries in the sorted part of the list
+void Cover::addRefInternal(const PcodeOp *ref,const Varnode *vn,int4 sorted)
+
 {
   int4 j;
   const FlowBlock *bl;
   uintm ustop;
 
   bl = ref->getParent();
-  CoverBlock &block(cover[bl->getIndex()]);
+  CoverBlock &block(getBlock(bl->getIndex(),sorted));
   if (block.empty()) {
     block.setEnd(ref);
   }
@@ -532,7 +640,7 @@ void Cover::addRefPoint(const PcodeOp *ref,const Varnode *vn)
 				// of cover through one branch of a MULTIEQUAL
 				// we still need to traverse through branches
 	  for(j=0;j<bl->sizeIn();++j)
-	    addRefRecurse(bl->getIn(j));
+	    addRefRecurse(bl->getIn(j),sorted);
 	}
 	return;
       }
@@ -543,18 +651,18 @@ void Cover::addRefPoint(const PcodeOp *ref,const Varnode *vn)
   if (ref->code() == CPUI_MULTIEQUAL) {
     for(j=0;j<ref->numInput();++j)
       if (ref->getIn(j)==vn)
-	addRefRecurse(bl->getIn(j));
+	addRefRecurse(bl->getIn(j),sorted);
   }
   else
     for(j=0;j<bl->sizeIn();++j)
-      addRefRecurse(bl->getIn(j));
+      addRefRecurse(bl->getIn(j),sorted);
 }
 
 /// \param s is the output stream
 void Cover::print(ostream &s) const
 
 {
-  map<int4,CoverBlock>::const_iterator iter;
+  BlockList::const_iterator iter;
 
   for(iter=cover.begin();iter!=cover.end();++iter) {
     s << dec << (*iter).first << ": ";
@@ -64,11 +64,20 @@ public:
 /// scope of each Varnode must not intersect because that would mean the high-level variable
 /// holds different values at the same point in the function.
 ///
-/// Internally this is implemented as a map from basic block to their non-empty CoverBlock
+/// Internally this is implemented as a list of (block index, CoverBlock) pairs, sorted by
+/// block index, with an entry for each basic block that is (partially) covered.  Keeping
+/// the pairs contiguous, instead of in a tree, lets the intersection tests stream over both lists.
 class Cover {
-  map<int4,CoverBlock> cover; 			///< block index -> CoverBlock
+public:
+  typedef vector<pair<int4,CoverBlock> > BlockList;	///< The sorted list of covered blocks
+private:
+  BlockList cover; 				///< (block index, CoverBlock) sorted by block index
   static const CoverBlock emptyBlock;		///< Global empty CoverBlock for blocks not covered by \b this
-  void addRefRecurse(const FlowBlock *bl);	///< Fill-in \b this recursively from the given block
+  BlockList::const_iterator findBlock(int4 blk) const;	///< Find the entry for a specific block
+  CoverBlock &getBlock(int4 blk,int4 sorted);	///< Get the entry for a specific block, creating it if necessary
+  void sortNewBlocks(int4 sorted);		///< Merge entries created by getBlock() into the sorted list
+  void addRefRecurse(const FlowBlock *bl,int4 sorted);	///< Fill-in \b this recursively from the given block
+  void addRefInternal(const PcodeOp *ref,const Varnode *vn,int4 sorted);	///< Add a variable read, leaving new entries unsorted
 public:
   void clear(void) { cover.clear(); }		///< Clear \b this to an empty Cover
   int4 compareTo(const Cover &op2) const;	///< Give ordering of \b this and another Cover
@@ -85,8 +94,8 @@ public:
   //  void remove_refpoint(const PcodeOp *ref,const Varnode *vn) {
   //    rebuild(vn); }		// Cheap but inefficient
   void print(ostream &s) const;			///< Dump a description of \b this cover to stream
-  map<int4,CoverBlock>::const_iterator begin(void) const { return cover.begin(); }	///< Get beginning of CoverBlocks
-  map<int4,CoverBlock>::const_iterator end(void) const { return cover.end(); }		///< Get end of CoverBlocks
+  BlockList::const_iterator begin(void) const { return cover.begin(); }	///< Get beginning of CoverBlocks
+  BlockList::const_iterator end(void) const { return cover.end(); }		///< Get end of CoverBlocks
 };
 
 #endif
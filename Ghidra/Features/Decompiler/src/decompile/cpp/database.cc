@@ -19,6 +19,7 @@
 #include <ctype.h>
 
 uint8 Symbol::ID_BASE = 0x4000000000000000L;
+ScopeLookupStatistics Database::lookupstats;
 
 /// This SymbolEntry is unintegrated. An address or hash must be provided
 /// either directly or via restoreXml().
@@ -1856,6 +1857,38 @@ list<SymbolEntry>::iterator ScopeInternal::endDynamic(void)
   return dynamicentry.end();
 }
 
+void ScopeLookupStatistics::reset(void)
+
+{
+  namelookup = 0;
+  namehit = 0;
+  nameprobe = 0;
+  addrlookup = 0;
+  addrhit = 0;
+  addrprobe = 0;
+  scopelookup = 0;
+  scopehit = 0;
+}
+
+/// The average number of probes per look-up is printed alongside the raw counts.
+/// \param s is the output stream
+void ScopeLookupStatistics::print(ostream &s) const
+
+{
+  s << "Symbol look-ups by name:" << endl;
+  s << "  Lookups=" << dec << namelookup << " Hits=" << namehit << " Probes=" << nameprobe;
+  if (namelookup != 0)
+    s << " Probes/lookup=" << (double)nameprobe / namelookup;
+  s << endl;
+  s << "Symbol look-ups by address:" << endl;
+  s << "  Lookups=" << addrlookup << " Hits=" << addrhit << " Probes=" << addrprobe;
+  if (addrlookup != 0)
+    s << " Probes/lookup=" << (double)addrprobe / addrlookup;
+  s << endl;
+  s << "Namespace look-ups by address:" << endl;
+  s << "  Lookups=" << scopelookup << " Hits=" << scopehit << endl;
+}
+
 /// \param id is the globally unique id associated with the scope
 /// \param nm is the name of the Scope
 /// \param g is the Architecture it belongs to
@@ -1863,6 +1896,7 @@ ScopeInternal::ScopeInternal(uint8 id,const string &nm,Architecture *g)
   : Scope(id,nm,g,this)
 {
   nextUniqueId = 0;
+  namehashcount = 0;
   maptable.resize(g->numSpaces(),(EntryMap *)0);
 }
 
@@ -1870,6 +1904,7 @@ ScopeInternal::ScopeInternal(uint8 id,const string &nm,Architecture *g, Scope *o
   : Scope(id,nm,g,own)
 {
   nextUniqueId = 0;
+  namehashcount = 0;
   maptable.resize(g->numSpaces(),(EntryMap *)0);
 }
 
@@ -2053,6 +2088,7 @@ void ScopeInternal::removeSymbol(Symbol *symbol)
   }
   removeSymbolMappings(symbol);
   nametree.erase(symbol);
+  removeNameHash(symbol);
   delete symbol;
 }
 
@@ -2060,6 +2096,7 @@ void ScopeInternal::renameSymbol(Symbol *sym,const string &newname)
 
 {
   nametree.erase(sym);		// Erase under old name
+  removeNameHash(sym);
   if (sym->wholeCount > 1)
     multiEntrySet.erase(sym);	// The multi-entry set is sorted by name, remove
   string oldname = sym->name;
@@ -2126,6 +2163,7 @@ void ScopeInternal::setDisplayFormat(Symbol *sym,uint4 attr)
 SymbolEntry *ScopeInternal::findAddr(const Address &addr,const Address &usepoint) const
 
 {
+  Database::lookupstats.addrlookup += 1;
   EntryMap *rangemap = maptable[ addr.getSpace()->getIndex() ];
   if (rangemap != (EntryMap *)0) {
     pair<EntryMap::const_iterator,EntryMap::const_iterator> res;
@@ -2139,10 +2177,13 @@ SymbolEntry *ScopeInternal::findAddr(const Address &addr,const Address &usepoint
 			   EntryMap::subsorttype(usepoint));
     while(res.first != res.second) {
       --res.second;
+      Database::lookupstats.addrprobe += 1;
       SymbolEntry *entry = &(*res.second);
       if (entry->getAddr().getOffset() == addr.getOffset()) {
-	if (entry->inUse(usepoint))
+	if (entry->inUse(usepoint)) {
+	  Database::lookupstats.addrhit += 1;
 	  return entry;
+	}
       }
     }
   }
@@ -2152,6 +2193,7 @@ SymbolEntry *ScopeInternal::findAddr(const Address &addr,const Address &usepoint
 SymbolEntry *ScopeInternal::findContainer(const Address &addr,int4 size,
 						   const Address &usepoint) const
 {
+  Database::lookupstats.addrlookup += 1;
   SymbolEntry *bestentry = (SymbolEntry *)0;
   EntryMap *rangemap = maptable[ addr.getSpace()->getIndex() ];
   if (rangemap != (EntryMap *)0) {
@@ -2168,6 +2210,7 @@ SymbolEntry *ScopeInternal::findContainer(const Address &addr,int4 size,
     uintb end = addr.getOffset() + size -1;
     while(res.first != res.second) {
       --res.second;
+      Database::lookupstats.addrprobe += 1;
       SymbolEntry *entry = &(*res.second);
       if (entry->getLast() >= end) { // We contain the range
 	if ((entry->getSize()<oldsize)||(oldsize==-1)) {
@@ -2180,12 +2223,15 @@ SymbolEntry *ScopeInternal::findContainer(const Address &addr,int4 size,
       }
     }
   }
+  if (bestentry != (SymbolEntry *)0)
+    Database::lookupstats.addrhit += 1;
   return bestentry;
 }
 
 SymbolEntry *ScopeInternal::findClosestFit(const Address &addr,int4 size,
 					   const Address &usepoint) const
 {
+  Database::lookupstats.addrlookup += 1;
   SymbolEntry *bestentry = (SymbolEntry *)0;
   EntryMap *rangemap = maptable[ addr.getSpace()->getIndex() ];
   if (rangemap != (EntryMap *)0) {
@@ -2203,6 +2249,7 @@ SymbolEntry *ScopeInternal::findClosestFit(const Address &addr,int4 size,
 
     while(res.first != res.second) {
       --res.second;
+      Database::lookupstats.addrprobe += 1;
       SymbolEntry *entry = &(*res.second);
       if (entry->getLast() >= addr.getOffset()) { // We contain start
 	newdiff = entry->getSize() - size;
@@ -2217,6 +2264,8 @@ SymbolEntry *ScopeInternal::findClosestFit(const Address &addr,int4 size,
       }
     }
   }
+  if (bestentry != (SymbolEntry *)0)
+    Database::lookupstats.addrhit += 1;
   return bestentry;
 }
 
@@ -2307,24 +2356,22 @@ SymbolEntry *ScopeInternal::findOverlap(const Address &addr,int4 size) const
 void ScopeInternal::findByName(const string &name,vector<Symbol *> &res) const
 
 {
-  SymbolNameTree::const_iterator iter = findFirstByName(name);
-  while(iter != nametree.end()) {
-    Symbol *sym = *iter;
-    if (sym->name != name) break;
+  Symbol *sym = findFirstHashed(name);
+  if (sym == (Symbol *)0) return;
+  int4 start = res.size();
+  do {
     res.push_back(sym);
-    ++iter;
-  }
+    sym = findNextHashed(sym);
+  } while(sym != (Symbol *)0);
+  if (res.size() - start > 1)	// Return duplicates in the same order as the nametree
+    sort(res.begin()+start,res.end(),compareDedup);
 }
 
 bool ScopeInternal::isNameUsed(const string &nm,const Scope *op2) const
 
 {
-  Symbol sym((Scope *)0,nm,(Datatype *)0);
-  SymbolNameTree::const_iterator iter = nametree.lower_bound(&sym);
-  if (iter != nametree.end()) {
-    if ((*iter)->getName() == nm)
-      return true;
-  }
+  if (findFirstHashed(nm) != (Symbol *)0)
+    return true;
   Scope *par = getParent();
   if (par == (Scope *)0 || par == op2)
     return false;
@@ -2404,13 +2451,13 @@ string ScopeInternal::buildVariableName(const Address &addr,
     if (ct != (Datatype *)0)
       ct->printNameBase(s);
     s << "Var" << dec << index++;
-    if (findFirstByName(s.str()) != nametree.end()) {	// If the name already exists
+    if (findFirstHashed(s.str()) != (Symbol *)0) {	// If the name already exists
       for(int4 i=0;i<10;++i) {	// Try bumping up the index a few times before calling makeNameUnique
 	ostringstream s2;
 	if (ct != (Datatype *)0)
 	  ct->printNameBase(s2);
 	s2 << "Var" << dec << index++;
-	if (findFirstByName(s2.str()) == nametree.end()) {
+	if (findFirstHashed(s2.str()) == (Symbol *)0) {
 	  return s2.str();
 	}
       }
@@ -2455,8 +2502,8 @@ string ScopeInternal::buildUndefinedName(void) const
 string ScopeInternal::makeNameUnique(const string &nm) const
 
 {
+  if (findFirstHashed(nm) == (Symbol *)0) return nm; // nm is already unique
   SymbolNameTree::const_iterator iter = findFirstByName(nm);
-  if (iter == nametree.end()) return nm; // nm is already unique
 
   Symbol boundsym((Scope *)0,nm+"_x99999",(Datatype *)0);
   boundsym.nameDedup = 0xffffffff;
@@ -2510,7 +2557,7 @@ string ScopeInternal::makeNameUnique(const string &nm) const
       s << 'x' << setw(5) << uniqid;
     resString = s.str();
   }
-  if (findFirstByName(resString) != nametree.end())
+  if (findFirstHashed(resString) != (Symbol *)0)
     throw LowlevelError("Unable to uniquify name: "+resString);
   return resString;
 }
@@ -2594,8 +2641,7 @@ void ScopeInternal::processCollision(const Element *el)
 
 {
   const string &nm(el->getAttributeValue("name"));
-  SymbolNameTree::const_iterator iter = findFirstByName(nm);
-  if (iter == nametree.end()) {
+  if (findFirstHashed(nm) == (Symbol *)0) {
     Datatype *ct = glb->types->getBase(1,TYPE_INT);
     addSymbol(nm,ct);
   }
@@ -2620,6 +2666,7 @@ void ScopeInternal::insertNameTree(Symbol *sym)
     if (!nameres.second)
       throw LowlevelError("Could  not deduplicate symbol: "+sym->name);
   }
+  insertNameHash(sym);
 }
 
 /// \brief Find an iterator pointing to the first Symbol in the ordering with a given name
@@ -2637,6 +2684,119 @@ SymbolNameTree::const_iterator ScopeInternal::findFirstByName(const string &name
   return iter;
 }
 
+/// The hash is FNV-1a over the characters of the name.
+/// \param nm is the name to hash
+/// \return the hash value
+uint4 ScopeInternal::hashName(const string &nm)
+
+{
+  uint4 res = 0x811c9dc5;
+  for(int4 i=0;i<nm.size();++i) {
+    res ^= (uint1)nm[i];
+    res *= 0x01000193;
+  }
+  return res;
+}
+
+/// Every Symbol currently in the index is moved to its bucket in the new table.
+/// \param numbuckets is the new number of buckets, which must be a power of 2
+void ScopeInternal::resizeNameHash(int4 numbuckets)
+
+{
+  vector<Symbol *> newhash(numbuckets,(Symbol *)0);
+  uint4 mask = numbuckets - 1;
+  for(int4 i=0;i<namehash.size();++i) {
+    Symbol *sym = namehash[i];
+    while(sym != (Symbol *)0) {
+      Symbol *next = sym->nextHash;
+      Symbol *&head( newhash[sym->nameHash & mask] );
+      sym->nextHash = head;
+      head = sym;
+      sym = next;
+    }
+  }
+  namehash.swap(newhash);
+}
+
+/// The table is doubled whenever the number of Symbols reaches the number of buckets.
+/// \param sym is the Symbol to add
+void ScopeInternal::insertNameHash(Symbol *sym)
+
+{
+  if (namehashcount >= namehash.size())
+    resizeNameHash(namehash.empty() ? 16 : namehash.size() * 2);
+  sym->nameHash = hashName(sym->name);
+  Symbol *&head( namehash[sym->nameHash & (namehash.size()-1)] );
+  sym->nextHash = head;
+  head = sym;
+  namehashcount += 1;
+}
+
+/// \param sym is the Symbol to remove
+void ScopeInternal::removeNameHash(Symbol *sym)
+
+{
+  if (namehash.empty()) return;
+  Symbol **ptr = &namehash[sym->nameHash & (namehash.size()-1)];
+  while(*ptr != (Symbol *)0) {
+    if (*ptr == sym) {
+      *ptr = sym->nextHash;
+      sym->nextHash = (Symbol *)0;
+      namehashcount -= 1;
+      return;
+    }
+    ptr = &(*ptr)->nextHash;
+  }
+}
+
+/// \param nm is the name to search for
+/// \return a Symbol with the given name, or null if there is none
+Symbol *ScopeInternal::findFirstHashed(const string &nm) const
+
+{
+  Database::lookupstats.namelookup += 1;
+  if (namehash.empty()) return (Symbol *)0;
+  uint4 hash = hashName(nm);
+  Symbol *sym = namehash[hash & (namehash.size()-1)];
+  while(sym != (Symbol *)0) {
+    Database::lookupstats.nameprobe += 1;
+    if (sym->nameHash == hash && sym->name == nm) {
+      Database::lookupstats.namehit += 1;
+      return sym;
+    }
+    sym = sym->nextHash;
+  }
+  return (Symbol *)0;
+}
+
+/// Symbols with the same name share a bucket, so only the rest of the chain needs to be searched.
+/// \param sym is a Symbol returned by findFirstHashed() or a previous call to this method
+/// \return the next Symbol in the chain with the same name, or null if there are no more
+Symbol *ScopeInternal::findNextHashed(Symbol *sym)
+
+{
+  Symbol *cur = sym->nextHash;
+  while(cur != (Symbol *)0) {
+    if (cur->nameHash == sym->nameHash && cur->name == sym->name)
+      return cur;
+    cur = cur->nextHash;
+  }
+  return (Symbol *)0;
+}
+
+/// Grow the hashed name index ahead of adding many Symbols at once, so that it is
+/// not rebuilt repeatedly as the Symbols are added.
+/// \param num is the total number of Symbols expected
+void ScopeInternal::reserveNames(int4 num)
+
+{
+  int4 numbuckets = namehash.empty() ? 16 : namehash.size();
+  while(numbuckets < num)
+    numbuckets *= 2;
+  if (numbuckets != namehash.size())
+    resizeNameHash(numbuckets);
+}
+
 void ScopeInternal::restoreXml(const Element *el)
 
 {
@@ -2665,6 +2825,7 @@ void ScopeInternal::restoreXml(const Element *el)
   }
   if (iter != list.end()) {
     const List &symlist((*iter)->getChildren());
+    reserveNames(namehashcount + symlist.size());	// Size the name index once for the whole list
     List::const_iterator iter2;
     iter2 = symlist.begin();
     while(iter2 != symlist.end()) {
@@ -3077,12 +3238,16 @@ Scope *Database::findCreateScopeFromSymbolName(const string &fullname,const stri
 /// \return a Scope to act as a starting point for a hierarchical search
 const Scope *Database::mapScope(const Scope *qpoint,const Address &addr,
 				const Address &usepoint) const
-{  if (resolvemap.empty())	// If there are no namespace scopes
+{
+  lookupstats.scopelookup += 1;
+  if (resolvemap.empty())	// If there are no namespace scopes
     return qpoint;		// Start querying from scope placing query
   pair<ScopeResolve::const_iterator,ScopeResolve::const_iterator> res;
   res = resolvemap.find(addr);
-  if (res.first != res.second)
+  if (res.first != res.second) {
+    lookupstats.scopehit += 1;
     return (*res.first).getScope();
+  }
   return qpoint;
 }
 
@@ -3095,12 +3260,15 @@ const Scope *Database::mapScope(const Scope *qpoint,const Address &addr,
 Scope *Database::mapScope(Scope *qpoint,const Address &addr,
 			  const Address &usepoint)
 {
+  lookupstats.scopelookup += 1;
   if (resolvemap.empty())	// If there are no namespace scopes
     return qpoint;		// Start querying from scope placing query
   pair<ScopeResolve::const_iterator,ScopeResolve::const_iterator> res;
   res = resolvemap.find(addr);
-  if (res.first != res.second)
+  if (res.first != res.second) {
+    lookupstats.scopehit += 1;
     return (*res.first).getScope();
+  }
   return qpoint;
 }
 
@@ -159,6 +159,8 @@ protected:
   string name;			///< The local name of the symbol
   Datatype *type;		///< The symbol's data-type
   uint4 nameDedup;		///< id to distinguish symbols with the same name
+  uint4 nameHash;		///< Hash of \b name, as used by the ScopeInternal name index
+  Symbol *nextHash;		///< Next Symbol in the same bucket of the ScopeInternal name index
   uint4 flags;			///< Varnode-like properties of the symbol
 				// only typelock,namelock,readonly,externref
 				// addrtied, persist inherited from scope
@@ -602,6 +604,14 @@ public:
   /// \return an overlapping SymbolEntry or NULL if none exists
   virtual SymbolEntry *findOverlap(const Address &addr,int4 size) const=0;
 
+  /// \brief Give \b this Scope a chance to fetch Symbols at many addresses at once
+  ///
+  /// A Scope backed by a remote symbol store can use this to answer, in a single query,
+  /// the look-ups that analysis of a function is about to make one address at a time.
+  /// The default implementation does nothing.
+  /// \param addrlist is the sorted list of addresses to fetch
+  virtual void prefetchAddresses(const vector<Address> &addrlist) const {}
+
   /// \brief Find a Symbol by name within \b this Scope
   ///
   /// If there are multiple Symbols with the same name, all are passed back.
@@ -718,17 +728,48 @@ public:
   void printBounds(ostream &s) const { rangetree.printBounds(s); }	///< Print a description of \b this Scope's \e owned memory ranges
 };
 
+/// \brief Counts of the work done by Symbol look-ups
+///
+/// Name look-ups are counted across all ScopeInternal objects, address look-ups cover
+/// ScopeInternal::findAddr(), findContainer() and findClosestFit(), and \e namespace look-ups
+/// cover Database::mapScope().  The number of \e probes, Symbols or SymbolEntrys examined before
+/// a look-up completes, serves as a measure of look-up latency.
+struct ScopeLookupStatistics {
+  uint4 namelookup;		///< Number of look-ups by name
+  uint4 namehit;		///< Number of name look-ups finding a Symbol
+  uint8 nameprobe;		///< Number of Symbols examined by name look-ups
+  uint4 addrlookup;		///< Number of look-ups by address
+  uint4 addrhit;		///< Number of address look-ups finding a SymbolEntry
+  uint8 addrprobe;		///< Number of SymbolEntrys examined by address look-ups
+  uint4 scopelookup;		///< Number of look-ups of the \e namespace owning an address
+  uint4 scopehit;		///< Number of \e namespace look-ups finding an owner
+  ScopeLookupStatistics(void) { reset(); }	///< Constructor
+  void reset(void);				///< Reset all counts to zero
+  void print(ostream &s) const;			///< Print the counts to a stream
+};
+
 /// \brief An in-memory implementation of the Scope interface.
 ///
 /// This can act as a stand-alone Scope object or serve as an in-memory cache for
 /// another implementation.  This implements a \b nametree, which is a
 /// a set of Symbol objects (the set owns the Symbol objects). It also implements
 /// a \b maptable, which is a list of rangemaps that own the SymbolEntry objects.
+/// Look-ups by name go through a separate hash index over the same Symbols, so that
+/// they don't need to walk the \b nametree.
 class ScopeInternal : public Scope {
+  vector<Symbol *> namehash;			///< Buckets of the hashed name index, chained through Symbol::nextHash
+  int4 namehashcount;				///< Number of Symbols in the hashed name index
   void processHole(const Element *el);
   void processCollision(const Element *el);
   void insertNameTree(Symbol *sym);
   SymbolNameTree::const_iterator findFirstByName(const string &name) const;
+  static uint4 hashName(const string &nm);	///< Calculate the hash of a Symbol name
+  static bool compareDedup(const Symbol *a,const Symbol *b) { return (a->nameDedup < b->nameDedup); }	///< Order Symbols sharing a name
+  void resizeNameHash(int4 numbuckets);		///< Rebuild the hashed name index with the given number of buckets
+  void insertNameHash(Symbol *sym);		///< Add a Symbol to the hashed name index
+  void removeNameHash(Symbol *sym);		///< Remove a Symbol from the hashed name index
+  Symbol *findFirstHashed(const string &nm) const;	///< Find any Symbol with the given name, using the hashed index
+  static Symbol *findNextHashed(Symbol *sym);	///< Find another Symbol with the same name in the hashed index
 protected:
   virtual Scope *buildSubScope(uint8 id,const string &nm);	///< Build an unattached Scope to be associated as a sub-scope of \b this
   virtual void addSymbolInternal(Symbol *sym);
@@ -791,6 +832,7 @@ public:
   virtual Symbol *getCategorySymbol(int4 cat,int4 ind) const;
   virtual void setCategory(Symbol *sym,int4 cat,int4 ind);
   void assignDefaultNames(int4 &base);		///< Assign a default name (via buildVariableName) to any unnamed symbol
+  void reserveNames(int4 num);			///< Size the hashed name index for the given number of Symbols
   set<Symbol *>::const_iterator beginMultiEntry(void) const { return multiEntrySet.begin(); }	///< Start of symbols with more than one entry
   set<Symbol *>::const_iterator endMultiEntry(void) const { return multiEntrySet.end(); }	///< End of symbols with more than one entry
 };
@@ -855,6 +897,7 @@ class Database {
   void fillResolve(Scope *scope);	///< Add the \e ownership ranges of the given Scope to the map
   Scope *parseParentTag(const Element *el);	///< Figure out parent scope given \<parent> tag.
 public:
+  static ScopeLookupStatistics lookupstats;	///< Counts of Symbol look-ups across all Scopes
   Database(Architecture *g,bool idByName);			///< Constructor
   ~Database(void);						///< Destructor
   Architecture *getArch(void) const { return glb; }		///< Get the Architecture associate with \b this
@@ -891,6 +934,8 @@ inline Symbol::Symbol(Scope *sc,const string &nm,Datatype *ct)
   scope=sc;
   name=nm;
   nameDedup=0;
+  nameHash=0;
+  nextHash=(Symbol *)0;
   type=ct;
   flags=0;
   dispflags=0;
@@ -908,6 +953,8 @@ inline Symbol::Symbol(Scope *sc)
 {
   scope=sc;
   nameDedup=0;
+  nameHash=0;
+  nextHash=(Symbol *)0;
   type = (Datatype *)0;
   flags=0;
   dispflags=0;
@@ -108,16 +108,15 @@ void ScopeGhidra::processHole(const Element *el) const
   }
 }
 
-/// Build the global object described by the XML document
+/// Build the global object described by the XML element
 /// and put it in the cache. The XML can either be a
 /// \<hole> tag, describing the absence of symbols at the queried
 /// address, or one of the symbol tags
-/// \param doc is the XML document
+/// \param el is the root element of the response
 /// \return the newly constructed Symbol or NULL if there was a hole
-Symbol *ScopeGhidra::dump2Cache(Document *doc) const
+Symbol *ScopeGhidra::dump2Cache(const Element *el) const
 
 {
-  const Element *el = doc->getRoot();
   Symbol *sym = (Symbol *)0;
 
   if (el->getName() == "hole") {
@@ -232,12 +231,55 @@ Symbol *ScopeGhidra::removeQuery(const Address &addr) const
   if (holes.inRange(addr,1)) return (Symbol *)0;
   doc = ghidra->getMappedSymbolsXML(addr); // Query GHIDRA about this address
   if (doc != (Document *)0) {
-    sym = dump2Cache(doc);	// Add it to the cache
+    sym = dump2Cache(doc->getRoot());	// Add it to the cache
     delete doc;
   }
   return sym;
 }
 
+/// Addresses that removeQuery() would not send to the client, because they are in the
+/// wrong space, inside a known hole, or already covered by the cache, are filtered out.
+/// The rest are sent in a single batched query, and each response is processed
+/// exactly as if it had come back from a single address query, filling in the cache and
+/// the \b holes map.  Nothing is prefetched unless the client agreed to answer batched queries
+/// when the program was registered.  Otherwise Symbols are fetched one address at a time.
+/// \param addrlist is the sorted list of addresses to fetch
+void ScopeGhidra::prefetchAddresses(const vector<Address> &addrlist) const
+
+{
+  if (!ghidra->getBatchSymbols()) return;
+  vector<Address> querylist;
+  for(int4 i=0;i<addrlist.size();++i) {
+    const Address &addr( addrlist[i] );
+    int4 index = addr.getSpace()->getIndex();
+    if (index >= spacerange.size() || spacerange[index] == 0) continue;
+    if (holes.inRange(addr,1)) continue;
+    if (cache->findContainer(addr,1,Address()) != (SymbolEntry *)0) continue;
+    querylist.push_back(addr);
+  }
+  if (querylist.size() < 2) return;	// Not worth a batch, leave any address to the normal query
+
+  Document *doc = ghidra->getMappedSymbolsBatchXML(querylist);
+  if (doc == (Document *)0) return;
+  try {
+    const List &list(doc->getRoot()->getChildren());
+    List::const_iterator iter = list.begin();
+    for(int4 i=0;i<querylist.size() && iter!=list.end();++i,++iter) {
+      const Element *el = *iter;
+      if (el->getName() == "none") continue;
+      // An earlier response may already cover this address, as a later single query would find
+      if (holes.inRange(querylist[i],1)) continue;
+      if (cache->findContainer(querylist[i],1,Address()) != (SymbolEntry *)0) continue;
+      dump2Cache(el);
+    }
+    delete doc;
+  }
+  catch(LowlevelError &err) {
+    delete doc;
+    throw err;
+  }
+}
+
 void ScopeGhidra::addRange(AddrSpace *spc,uintb first,uintb last)
 
 {
@@ -374,7 +416,7 @@ Funcdata *ScopeGhidra::resolveExternalRefFunction(ExternRefSymbol *sym) const
     if (doc != (Document *)0) {
       FunctionSymbol *sym;
       // Make sure referenced function is cached
-      sym = dynamic_cast<FunctionSymbol *>(dump2Cache(doc));
+      sym = dynamic_cast<FunctionSymbol *>(dump2Cache(doc->getRoot()));
       delete doc;
       if (sym != (FunctionSymbol *)0)
 	fd = sym->getFunction();
@@ -39,7 +39,7 @@ class ScopeGhidra : public Scope {
   vector<int4> spacerange;		///< List of address spaces that are in the global range
   partmap<Address,uint4> flagbaseDefault;	///< Default boolean properties on memory
   mutable bool cacheDirty;		///< Is flagbaseDefault different from cache
-  Symbol *dump2Cache(Document *doc) const;			///< Parse a response into the cache
+  Symbol *dump2Cache(const Element *el) const;			///< Parse a response into the cache
   Symbol *removeQuery(const Address &addr) const;		///< Process a query that missed the cache
   void processHole(const Element *el) const;			///< Process a response describing a hole
   Scope *reresolveScope(uint8 id) const;	///< Find the Scope that will contain a result Symbol
@@ -89,6 +89,7 @@ public:
   virtual Funcdata *resolveExternalRefFunction(ExternRefSymbol *sym) const;
 
   virtual SymbolEntry *findOverlap(const Address &addr,int4 size) const { throw LowlevelError("findOverlap unimplemented"); }
+  virtual void prefetchAddresses(const vector<Address> &addrlist) const;
   virtual void findByName(const string &name,vector<Symbol *> &res) const { throw LowlevelError("findByName unimplemented"); }
   virtual bool isNameUsed(const string &nm,const Scope *op2) const { throw LowlevelError("isNameUsed unimplemented"); }
 
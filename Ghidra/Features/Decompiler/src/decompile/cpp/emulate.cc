@@ -330,13 +330,20 @@ EmulatePcodeCache::EmulatePcodeCache(Translate *t,MemoryState *s,BreakTable *b)
   : EmulateMemory(s)
 {
   trans = t;
+  current = &scratch;
+  usecache = false;
+  maxentries = 0;
+  contextdb = (ContextDatabase *)0;
+  maxlength = 0;
+  current_op = 0;
+  instruction_start = true;
   OpBehavior::registerInstructions(inst,t);
   breaktable = b;
   breaktable->setEmulate(this);
 }
 
-/// Free all the VarnodeData and PcodeOpRaw objects and clear the cache
-void EmulatePcodeCache::clearCache(void)
+/// Free all the VarnodeData and PcodeOpRaw objects
+void EmulatePcodeCache::Translation::clear(void)
 
 {
   for(int4 i=0;i<opcache.size();++i)
@@ -345,12 +352,34 @@ void EmulatePcodeCache::clearCache(void)
     delete varcache[i];
   opcache.clear();
   varcache.clear();
+  length = 0;
+}
+
+/// \param op2 is the key to compare with
+/// \return \b true if \b this comes before \b op2
+bool EmulatePcodeCache::TranslationKey::operator<(const TranslationKey &op2) const
+
+{
+  if (addr != op2.addr)
+    return (addr < op2.addr);
+  return (context < op2.context);
+}
+
+/// \param op2 is the other Translation
+void EmulatePcodeCache::Translation::swap(Translation &op2)
+
+{
+  opcache.swap(op2.opcache);
+  varcache.swap(op2.varcache);
+  int4 tmp = length;
+  length = op2.length;
+  op2.length = tmp;
 }
 
 EmulatePcodeCache::~EmulatePcodeCache(void)
 
 {
-  clearCache();
+  clearTranslationCache();
   for(int4 i=0;i<inst.size();++i) {
     OpBehavior *t_op = inst[i];
     if (t_op != (OpBehavior *)0)
@@ -359,24 +388,122 @@ EmulatePcodeCache::~EmulatePcodeCache(void)
 }
 
 /// This is a private routine which does the work of translating a machine instruction
-/// into pcode, putting it into the cache, and setting up the iterators
+/// into pcode, putting it into the cache, and setting up the iterators. If a translation
+/// for the address and its current context is already cached, it is reused.
 /// \param addr is the address of the instruction to translate
 void EmulatePcodeCache::createInstruction(const Address &addr)
 
 {
-  clearCache();
-  PcodeEmitCache emit(opcache,varcache,inst,0);
-  instruction_length = trans->oneInstruction(emit,addr);
+  map<TranslationKey,Translation *>::iterator iter = transcache.end();
+  if (usecache) {
+    searchkey.addr = addr;
+    if (contextdb != (ContextDatabase *)0) {
+      const uintm *ctx = contextdb->getContext(addr);
+      for(int4 i=0;i<searchkey.context.size();++i)
+	searchkey.context[i] = ctx[i];
+    }
+    iter = transcache.find(searchkey);
+  }
+  if (iter != transcache.end())
+    current = (*iter).second;
+  else {
+    current = &scratch;
+    scratch.clear();
+    PcodeEmitCache emit(scratch.opcache,scratch.varcache,inst,0);
+    scratch.length = trans->oneInstruction(emit,addr);
+    if (usecache) {
+      if (transcache.size() >= maxentries)
+	clearTranslationCache();
+      current = new Translation();
+      current->swap(scratch);
+      transcache[searchkey] = current;
+      if (current->length > maxlength)
+	maxlength = current->length;
+    }
+  }
   current_op = 0;
   instruction_start = true;
 }
 
+/// The cache is off by default.  Translations depend on the context in effect at each instruction,
+/// so the context database used by the translator must be given, unless the processor has no context.
+/// When caching is turned off, any existing translations are thrown out.
+/// \param val is \b true to cache translations, \b false to translate every instruction executed
+/// \param db is the context database used by the translator, or null
+/// \param max is the maximum number of translations to keep before the cache is emptied
+void EmulatePcodeCache::setTranslationCache(bool val,ContextDatabase *db,int4 max)
+
+{
+  clearTranslationCache();
+  contextdb = (ContextDatabase *)0;
+  searchkey.context.clear();
+  usecache = val;
+  maxentries = max;
+  if (!usecache) return;
+  if (maxentries < 1)
+    throw LowlevelError("Translation cache must hold at least one instruction");
+  if (db != (ContextDatabase *)0 && db->getContextSize() > 0) {
+    contextdb = db;		// Query the database directly, so context written by the translator is seen
+    searchkey.context.resize(db->getContextSize(),0);
+  }
+}
+
+/// This must be called if the machine code used by the translator changes.
+/// The translation of the current instruction remains valid until execution moves on.
+void EmulatePcodeCache::clearTranslationCache(void)
+
+{
+  map<TranslationKey,Translation *>::iterator iter;
+  for(iter=transcache.begin();iter!=transcache.end();++iter) {
+    Translation *tr = (*iter).second;
+    if (tr == current) {	// Keep ops of the current instruction alive
+      scratch.clear();
+      scratch.swap(*tr);
+      current = &scratch;
+    }
+    delete tr;
+  }
+  transcache.clear();
+  maxlength = 0;
+}
+
+/// Any cached instruction containing a byte in the given range is removed from the cache.
+/// \param addr is the starting address of the range
+/// \param size is the number of bytes in the range
+void EmulatePcodeCache::invalidateTranslation(const Address &addr,int4 size)
+
+{
+  if (transcache.empty()) return;
+  uintb off = addr.getOffset();
+  uintb start = (off < maxlength) ? 0 : off - maxlength + 1;
+  TranslationKey startkey;
+  startkey.addr = Address(addr.getSpace(),start);	// Empty context sorts first
+  map<TranslationKey,Translation *>::iterator iter = transcache.lower_bound(startkey);
+  while(iter != transcache.end()) {
+    const Address &instaddr( (*iter).first.addr );
+    if (instaddr.getSpace() != addr.getSpace()) break;
+    if (instaddr.getOffset() >= off + size) break;
+    Translation *tr = (*iter).second;
+    if (instaddr.getOffset() + tr->length <= off) {
+      ++iter;
+      continue;
+    }
+    if (tr == current) {	// Keep ops of the current instruction alive
+      scratch.clear();
+      scratch.swap(*tr);
+      current = &scratch;
+    }
+    delete tr;
+    transcache.erase(iter++);
+  }
+}
+
 /// Set-up currentOp and currentBehave
 void EmulatePcodeCache::establishOp(void)
 
 {
-  if (current_op < opcache.size()) {
-    currentOp = opcache[current_op];
+  if (current_op < current->opcache.size()) {
+    currentOp = current->opcache[current_op];
     currentBehave = currentOp->getBehavior();
     return;
   }
@@ -391,8 +518,8 @@ void EmulatePcodeCache::fallthruOp(void)
 {
   instruction_start = false;
   current_op += 1;
-  if (current_op >= opcache.size()) {
-    current_address = current_address + instruction_length;
+  if (current_op >= current->opcache.size()) {
+    current_address = current_address + current->length;
     createInstruction(current_address);
   }
   establishOp();
@@ -407,15 +534,28 @@ void EmulatePcodeCache::executeBranch(void)
     uintm id = destaddr.getOffset();
     id = id + (uintm)current_op;
     current_op = id;
-    if (current_op == opcache.size())
+    if (current_op == current->opcache.size())
       fallthruOp();
-    else if ((current_op < 0)||(current_op >= opcache.size()))
+    else if ((current_op < 0)||(current_op >= current->opcache.size()))
       throw LowlevelError("Bad intra-instruction branch");
   }
   else
     setExecuteAddress(destaddr);
 }
 
+/// The store is performed as usual, then any cached translation of an instruction overlapping
+/// the bytes written is thrown out.
+void EmulatePcodeCache::executeStore(void)
+
+{
+  uintb off = memstate->getValue(currentOp->getInput(1)); // Offset to store at
+  AddrSpace *spc = Address::getSpaceFromConst(currentOp->getInput(0)->getAddr()); // Space to store in
+  off = AddrSpace::addressToByte(off,spc->getWordSize());
+  int4 size = currentOp->getInput(2)->size;
+  EmulateMemory::executeStore();
+  invalidateTranslation(Address(spc,off),size);
+}
+
 /// Look for a breakpoint for the given user-defined op and invoke it.
 /// If it doesn't exist, or doesn't replace the action, throw an exception
 void EmulatePcodeCache::executeCallother(void)
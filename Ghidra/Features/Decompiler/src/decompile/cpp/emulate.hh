@@ -21,6 +21,7 @@
 
 #include "memstate.hh"
 #include "translate.hh"
+#include "globalcontext.hh"
 
 class Emulate;			// Forward declaration
 
@@ -293,26 +294,57 @@ public:
 /// pcode and caches pcode ops for later use by the emulator.  The pcode is cached as soon
 /// as the execution address is set, either explicitly, or via branches and fallthrus.  There
 /// are additional methods for inspecting the pcode ops in the current instruction as a sequence.
+///
+/// If turned on with setTranslationCache(), the translation of every instruction executed is also
+/// kept in a translation cache, so an instruction executed repeatedly is only translated by SLEIGH once.
+/// Translations are keyed by address and by the context in effect at the address, and the cache is
+/// emptied when it reaches a maximum number of entries.  A p-code STORE that overwrites a cached
+/// instruction removes its translation. If the underlying load image is changed by the application,
+/// clearTranslationCache() must be called.
 class EmulatePcodeCache : public EmulateMemory {
+  /// \brief The p-code translation of a single machine instruction
+  struct Translation {
+    vector<PcodeOpRaw *> opcache;	///< The p-code ops of the instruction
+    vector<VarnodeData *> varcache;	///< The varnodes of the instruction
+    int4 length;			///< Length of the instruction in bytes
+    Translation(void) { length = 0; }	///< Constructor
+    ~Translation(void) { clear(); }	///< Destructor
+    void clear(void);			///< Free all the p-code ops and varnodes
+    void swap(Translation &op2);	///< Swap contents with another Translation
+  };
+  /// \brief The address of a cached instruction and the context it was translated in
+  struct TranslationKey {
+    Address addr;			///< Address of the instruction
+    vector<uintm> context;		///< Context words in effect at the address
+    bool operator<(const TranslationKey &op2) const;	///< Compare by address, then by context
+  };
   Translate *trans;		///< The SLEIGH translator
-  vector<PcodeOpRaw *> opcache;	///< The cache of current p-code ops
-  vector<VarnodeData *> varcache;	///< The cache of current varnodes
+  Translation scratch;		///< Translation of an instruction not in the cache
+  Translation *current;		///< Translation of the current instruction
+  map<TranslationKey,Translation *> transcache;	///< Cache of translations by instruction address and context
+  bool usecache;		///< \b true if translations are cached
+  int4 maxentries;		///< Maximum number of translations in the cache
+  ContextDatabase *contextdb;	///< Context seen by the translator (null if it has none)
+  TranslationKey searchkey;	///< Key for the instruction being looked up
+  int4 maxlength;		///< Length of the longest instruction in the cache
   vector<OpBehavior *> inst;	///< Map from OpCode to OpBehavior
   BreakTable *breaktable;	///< The table of breakpoints
   Address current_address;	///< Address of current instruction being executed
   bool instruction_start;	///< \b true if next pcode op is start of instruction
   int4 current_op;		///< Index of current pcode op within machine instruction
-  int4 instruction_length;	///< Length of current instruction in bytes
-  void clearCache(void);	///< Clear the p-code cache
   void createInstruction(const Address &addr); ///< Cache pcode for instruction at given address
   void establishOp(void);
 protected:
   virtual void fallthruOp(void); ///< Execute fallthru semantics for the pcode cache
+  virtual void executeStore(void); ///< Execute a STORE, invalidating any overwritten translations
   virtual void executeBranch(void); ///< Execute branch (including relative branches)
   virtual void executeCallother(void); ///< Execute breakpoint for this user-defined op
 public:
   EmulatePcodeCache(Translate *t,MemoryState *s,BreakTable *b);	///< Pcode cache emulator constructor
   ~EmulatePcodeCache(void);
+  void setTranslationCache(bool val,ContextDatabase *db,int4 max);	///< Turn caching of instruction translations on or off
+  void clearTranslationCache(void);	///< Throw out all cached instruction translations
+  void invalidateTranslation(const Address &addr,int4 size);	///< Throw out translations overlapping a range
   bool isInstructionStart(void) const; ///< Return \b true if we are at an instruction start
   int4 numCurrentOps(void) const; ///< Return number of pcode ops in translation of current instruction
   int4 getCurrentOpIndex(void) const; ///< Get the index of current pcode op within current instruction
@@ -338,7 +370,7 @@ inline bool EmulatePcodeCache::isInstructionStart(void) const
 inline int4 EmulatePcodeCache::numCurrentOps(void) const
 
 {
-  return opcache.size();
+  return current->opcache.size();
 }
 
 /// This routine can be used to determine where, within the sequence of ops in the translation
@@ -357,7 +389,7 @@ inline int4 EmulatePcodeCache::getCurrentOpIndex(void) const
 inline PcodeOpRaw *EmulatePcodeCache::getOpByIndex(int4 i) const
 
 {
-  return opcache[i];
+  return current->opcache[i];
 }
 
 /// \return the currently executing machine address
@@ -431,7 +463,8 @@ inline Address EmulatePcodeCache::getExecuteAddress(void) const
 
   A MemoryPageOverlay overlays another memory bank as well.  But it implements writes to the bank
   by caching memory \e pages.  Any write creates an aligned page to hold the new data.  The class
-  takes care of loading and filling in pages as needed.
+  takes care of loading and filling in pages as needed.  A MemoryPageTable behaves the same way,
+  but finds its pages through a page table, which is faster when many pages have been written.
 
   Here is an example of instantiating a MemoryState and registering memory banks for a
   \e ram space which is initialized with the load image. The \e ram space is implemented
@@ -93,6 +93,7 @@ void Funcdata::clear(void)
   clearJumpTables();
   // Do not clear overrides
   heritage.clear();
+  covermerge.clear();
 #ifdef OPACTION_DEBUG
   opactdbg_count = 0;
 #endif
@@ -149,9 +150,36 @@ void Funcdata::startProcessing(void)
   structureReset();
   sortCallSpecs();		// Must come after structure reset
   heritage.buildInfoList();
+  prefetchSymbols();
   localoverride.applyDeadCodeDelay(*this);
 }
 
+/// Once flow is recovered, the memory Varnodes and direct call destinations of the function
+/// are known, and analysis will look up the Symbol at each of them.  Pass all the
+/// addresses to the global Scope at once, so that a Scope backed by a remote store
+/// can fetch them in a single query rather than one query per address.
+void Funcdata::prefetchSymbols(void) const
+
+{
+  vector<Address> addrlist;
+  VarnodeLocSet::const_iterator iter;
+  for(iter=beginLoc();iter!=endLoc();++iter) {
+    const Address &addr( (*iter)->getAddr() );
+    if (addr.getSpace()->getType() != IPTR_PROCESSOR) continue;
+    if (!addrlist.empty() && addrlist.back() == addr) continue;
+    addrlist.push_back(addr);
+  }
+  for(int4 i=0;i<qlst.size();++i) {
+    const Address &addr( qlst[i]->getEntryAddress() );
+    if (!addr.isInvalid())
+      addrlist.push_back(addr);
+  }
+  if (addrlist.empty()) return;
+  sort(addrlist.begin(),addrlist.end());
+  addrlist.erase(unique(addrlist.begin(),addrlist.end()),addrlist.end());
+  glb->symboltab->getGlobalScope()->prefetchAddresses(addrlist);
+}
+
 void Funcdata::stopProcessing(void)
 
 {
@@ -96,6 +96,8 @@ class Funcdata {
   void destroyVarnode(Varnode *vn);		///< Delete the given Varnode from \b this function
 				// Low level op functions
   void opZeroMulti(PcodeOp *op);		///< Transform trivial CPUI_MULTIEQUAL to CPUI_COPY
+  void opMarkRevisit(PcodeOp *op);		///< Mark the given PcodeOp and its neighbors for a rule revisit
+  void varnodeMarkRevisit(Varnode *vn);		///< Mark the defining PcodeOp and any lone reader of the given Varnode for a rule revisit
 				// Low level block functions
   void blockRemoveInternal(BlockBasic *bb,bool unreachable);
   void branchRemoveInternal(BlockBasic *bb,int4 num);
@@ -107,6 +109,7 @@ class Funcdata {
   void clearJumpTables(void);			///< Clear any jump-table information
 
   void sortCallSpecs(void);			///< Sort calls using a dominance based order
+  void prefetchSymbols(void) const;		///< Let the global Scope fetch Symbols referenced by the recovered flow
   void deleteCallSpecs(PcodeOp *op);		///< Remove the specification for a particular call
   void clearCallSpecs(void);			///< Remove all call specifications
 
@@ -441,6 +444,7 @@ public:
   void opMarkSpecialPrint(PcodeOp *op) { op->setAdditionalFlag(PcodeOp::special_print); }	///< Mark PcodeOp as needing special printing
   void opMarkNoCollapse(PcodeOp *op) { op->setFlag(PcodeOp::nocollapse); }	///< Mark PcodeOp as not collapsible
   void opMarkCpoolTransformed(PcodeOp *op) { op->setAdditionalFlag(PcodeOp::is_cpool_transformed); }	///< Mark cpool record was visited
+  void opClearRevisit(PcodeOp *op) { op->clearAdditionalFlag(PcodeOp::revisit); }	///< Mark PcodeOp as examined by rules
   void opMarkCalculatedBool(PcodeOp *op) { op->setFlag(PcodeOp::calculated_bool); }	///< Mark PcodeOp as having boolean output
   void opMarkSpacebasePtr(PcodeOp *op) { op->setFlag(PcodeOp::spacebase_ptr); }	///< Mark PcodeOp as LOAD/STORE from spacebase ptr
   void opClearSpacebasePtr(PcodeOp *op) { op->clearFlag(PcodeOp::spacebase_ptr); }	///< Unmark PcodeOp as using spacebase ptr
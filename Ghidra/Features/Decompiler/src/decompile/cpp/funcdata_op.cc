@@ -27,6 +27,7 @@ void Funcdata::opSetOpcode(PcodeOp *op,OpCode opc)
   if (opactdbg_active)
     debugModCheck(op);
 #endif
+  opMarkRevisit(op);
   obank.changeOpcode(op, glb->inst[opc] );
 }
 
@@ -58,6 +59,7 @@ void Funcdata::opUnsetOutput(PcodeOp *op)
   if (opactdbg_active)
     debugModCheck(op);
 #endif
+  opMarkRevisit(op);		// Marks the readers of vn as well
   op->setOutput((Varnode *)0); // This must come before make_free
   vbank.makeFree(vn);
   vn->clearCover();
@@ -82,6 +84,7 @@ void Funcdata::opSetOutput(PcodeOp *op,Varnode *vn)
   vn = vbank.setDef(vn,op);
   setVarnodeProperties(vn);
   op->setOutput(vn);
+  opMarkRevisit(op);
 }
 
 /// The input Varnode is unlinked from the op.
@@ -94,6 +97,8 @@ void Funcdata::opUnsetInput(PcodeOp *op,int4 slot)
 
   vn->eraseDescend(op);
   op->clearInput(slot);		// Must be called AFTER descend_erase
+  op->setAdditionalFlag(PcodeOp::revisit);
+  varnodeMarkRevisit(vn);
 }
 
 /// \param op is the given PcodeOp
@@ -120,6 +125,8 @@ void Funcdata::opSetInput(PcodeOp *op,Varnode *vn,int4 slot)
 
   vn->addDescend(op);		// Add this op to list of vn's descendants
   op->setInput(vn,slot);	// op must be up to date AFTER calling descend_add
+  op->setAdditionalFlag(PcodeOp::revisit);
+  varnodeMarkRevisit(vn);
 }
 
 /// This is convenience method that is more efficient than call opSetInput() twice.
@@ -136,6 +143,7 @@ void Funcdata::opSwapInput(PcodeOp *op,int4 slot1,int4 slot2)
   Varnode *tmp = op->getIn(slot1);
   op->setInput(op->getIn(slot2),slot1);
   op->setInput(tmp,slot2);
+  op->setAdditionalFlag(PcodeOp::revisit);
 }
 
 /// \brief Insert the given PcodeOp at specific point in a basic block
@@ -154,6 +162,7 @@ void Funcdata::opInsert(PcodeOp *op,BlockBasic *bl,list<PcodeOp *>::iterator ite
 #endif
   obank.markAlive(op);
   bl->insert(iter,op);
+  opMarkRevisit(op);
 }
 
 /// The op is taken out of its basic block and put into the dead list. If the removal
@@ -166,6 +175,7 @@ void Funcdata::opUninsert(PcodeOp *op)
   if (opactdbg_active)
     debugModCheck(op);
 #endif
+  opMarkRevisit(op);
   obank.markDead(op);
   op->getParent()->removeOp(op);
 }
@@ -270,6 +280,7 @@ void Funcdata::opRemoveInput(PcodeOp *op,int4 slot)
 #endif
   opUnsetInput(op,slot);
   op->removeInput(slot);
+  op->setAdditionalFlag(PcodeOp::revisit);
 }
 
 /// The given Varnode is set into the given operand slot. Any existing input Varnodes
@@ -289,6 +300,44 @@ void Funcdata::opInsertInput(PcodeOp *op,Varnode *vn,int4 slot)
   opSetInput(op,vn,slot);
 }
 
+/// The PcodeOp is flagged so that the next partial pass of an ActionPool examines it again,
+/// along with the op defining each of its inputs and every op reading its output.
+/// Rules making decisions based on a wider neighborhood are picked up by the final full pass.
+/// \param op is the given PcodeOp
+void Funcdata::opMarkRevisit(PcodeOp *op)
+
+{
+  if (!glb->partial_rule_passes) return;
+  op->setAdditionalFlag(PcodeOp::revisit);
+  Varnode *outvn = op->getOut();
+  if (outvn != (Varnode *)0) {
+    list<PcodeOp *>::const_iterator iter;
+    for(iter=outvn->beginDescend();iter!=outvn->endDescend();++iter)
+      (*iter)->setAdditionalFlag(PcodeOp::revisit);
+  }
+  for(int4 i=0;i<op->numInput();++i) {
+    Varnode *vn = op->getIn(i);
+    if (vn != (Varnode *)0 && vn->isWritten())
+      vn->getDef()->setAdditionalFlag(PcodeOp::revisit);
+  }
+}
+
+/// This is called when a PcodeOp starts or stops reading the Varnode.  The defining PcodeOp
+/// is flagged so that the next partial pass of an ActionPool examines it again.  If the
+/// Varnode is now read by a single PcodeOp, that reader is flagged too, as rules testing for a
+/// lone descendant may now apply to it.  Other readers are left alone.
+/// \param vn is the given Varnode
+void Funcdata::varnodeMarkRevisit(Varnode *vn)
+
+{
+  if (!glb->partial_rule_passes) return;
+  if (vn->isWritten())
+    vn->getDef()->setAdditionalFlag(PcodeOp::revisit);
+  PcodeOp *lone = vn->loneDescend();
+  if (lone != (PcodeOp *)0)
+    lone->setAdditionalFlag(PcodeOp::revisit);
+}
+
 /// \param inputs is the number of operands the new op will have
 /// \param pc is the Address associated with the new op
 /// \return the new PcodeOp
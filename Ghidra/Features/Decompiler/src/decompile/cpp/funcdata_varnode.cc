@@ -278,6 +278,7 @@ void Funcdata::destroyVarnode(Varnode *vn)
     if (opactdbg_active)
       debugModCheck(op);
 #endif
+    op->setAdditionalFlag(PcodeOp::revisit);
     op->clearInput(op->getSlot(vn));
   }
   if (vn->def != (PcodeOp *)0) {
@@ -140,6 +140,7 @@ void ArchitectureGhidra::readStringStream(istream &s,string &res)
 
 /// The method expects to see protocol markers indicating a string from the client,
 /// otherwise it throws and exception.  The string is read in and then parsed as XML.
+/// If the string starts with the packed magic byte, it is decoded as a packed message instead.
 /// \param s is the input stream from the client.
 /// \return the XML document
 Document *ArchitectureGhidra::readXMLStream(istream &s)
@@ -147,6 +148,18 @@ Document *ArchitectureGhidra::readXMLStream(istream &s)
 {
   int4 type = readToAnyBurst(s);
   if (type==14) {
+    if (s.peek() == PackedXmlWriter::magic) {
+      string buf;
+      int4 c = s.get();
+      while(c > 0) {
+	buf += (char)c;
+	c = s.get();
+      }
+      type = readToAnyBurst(s);
+      if (type!=15)
+	throw JavaError("alignment","Expecting packed string end");
+      return packed_tree(buf);
+    }
     Document *doc = xml_tree(s);
     type = readToAnyBurst(s);
     if (type!=15)
@@ -277,20 +290,16 @@ void ArchitectureGhidra::passJavaException(ostream &s,const string &tp,const str
 void ArchitectureGhidra::buildSpecFile(DocumentStorage &store)
 
 { // Spec files are passed as XML strings from GHIDRA
-  istringstream pstream(pspecxml); // Convert string to stream
-  Document *doc = store.parseDocument(pstream); // parse stream
+  Document *doc = store.parseDocument(pspecxml); // parse string directly
   store.registerTag(doc->getRoot());
   
-  istringstream cstream(cspecxml);
-  doc = store.parseDocument(cstream);
+  doc = store.parseDocument(cspecxml);
   store.registerTag(doc->getRoot());
   
-  istringstream tstream(tspecxml);
-  doc = store.parseDocument(tstream);
+  doc = store.parseDocument(tspecxml);
   store.registerTag(doc->getRoot());
 
-  istringstream corestream(corespecxml);
-  doc = store.parseDocument(corestream);
+  doc = store.parseDocument(corespecxml);
   store.registerTag(doc->getRoot());
 
   pspecxml = "";		// Strings aren't used again free memory
@@ -405,6 +414,7 @@ void ArchitectureGhidra::resolveArchitecture(void)
 Document *ArchitectureGhidra::getRegister(const string &regname)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getRegister");
   writeStringStream(sout,regname);
@@ -422,6 +432,7 @@ Document *ArchitectureGhidra::getRegister(const string &regname)
 string ArchitectureGhidra::getRegisterName(const VarnodeData &vndata)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getRegisterName");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -447,6 +458,7 @@ string ArchitectureGhidra::getRegisterName(const VarnodeData &vndata)
 Document *ArchitectureGhidra::getTrackedRegisters(const Address &addr)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getTrackedRegisters");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -465,6 +477,7 @@ Document *ArchitectureGhidra::getTrackedRegisters(const Address &addr)
 string ArchitectureGhidra::getUserOpName(int4 index)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getUserOpName");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -488,6 +501,7 @@ string ArchitectureGhidra::getUserOpName(int4 index)
 uint1 *ArchitectureGhidra::getPcodePacked(const Address &addr)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getPacked");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -508,8 +522,10 @@ uint1 *ArchitectureGhidra::getPcodePacked(const Address &addr)
 Document *ArchitectureGhidra::getMappedSymbolsXML(const Address &addr)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getMappedSymbolsXML");
+  numsymbolqueries += 1;
   sout.write("\000\000\001\016",4); // Beginning of string header
   addr.saveXml(sout);
   sout.write("\000\000\001\017",4);
@@ -519,6 +535,34 @@ Document *ArchitectureGhidra::getMappedSymbolsXML(const Address &addr)
   return readXMLAll(sin);
 }
 
+/// The Ghidra client will return a \<batch> tag, with a child for each address in the
+/// order they were sent. Each child is the same tag getMappedSymbolsXML() would return
+/// for the address, or an empty \<none> tag if the client has no response for it.
+/// \param addrlist is the list of addresses to query
+/// \return the batch document
+Document *ArchitectureGhidra::getMappedSymbolsBatchXML(const vector<Address> &addrlist)
+
+{
+  numqueries += 1;
+  numbatchaddrs += addrlist.size();
+  sout.write("\000\000\001\004",4);
+  writeStringStream(sout,"getMappedSymbolsBatchXML");
+  sout.write("\000\000\001\016",4); // Beginning of string header
+  ostringstream numstr;		// Format the count without changing the base of the stream
+  numstr << dec << addrlist.size();
+  sout << numstr.str();
+  sout.write("\000\000\001\017",4);
+  for(int4 i=0;i<addrlist.size();++i) {
+    sout.write("\000\000\001\016",4);
+    addrlist[i].saveXml(sout);
+    sout.write("\000\000\001\017",4);
+  }
+  sout.write("\000\000\001\005",4);
+  sout.flush();
+
+  return readXMLAll(sin);
+}
+
 /// This asks the Ghidra client to resolve an \e external \e reference.
 /// This is an address for which the client holds a reference to a function
 /// that is elsewhere in memory or not in memory at all.  The client
@@ -530,6 +574,7 @@ Document *ArchitectureGhidra::getMappedSymbolsXML(const Address &addr)
 Document *ArchitectureGhidra::getExternalRefXML(const Address &addr)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getExternalRefXML");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -549,6 +594,7 @@ Document *ArchitectureGhidra::getExternalRefXML(const Address &addr)
 Document *ArchitectureGhidra::getNamespacePath(uint8 id)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getNamespacePath");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -563,6 +609,7 @@ Document *ArchitectureGhidra::getNamespacePath(uint8 id)
 bool ArchitectureGhidra::isNameUsed(const string &nm,uint8 startId,uint8 stopId)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"isNameUsed");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -590,6 +637,7 @@ bool ArchitectureGhidra::isNameUsed(const string &nm,uint8 startId,uint8 stopId)
 string ArchitectureGhidra::getCodeLabel(const Address &addr)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getSymbol");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -613,6 +661,7 @@ string ArchitectureGhidra::getCodeLabel(const Address &addr)
 Document *ArchitectureGhidra::getType(const string &name,uint8 id)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getType");
   writeStringStream(sout,name);
@@ -635,6 +684,7 @@ Document *ArchitectureGhidra::getType(const string &name,uint8 id)
 Document *ArchitectureGhidra::getComments(const Address &fad,uint4 flags)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getComments");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -658,6 +708,7 @@ Document *ArchitectureGhidra::getComments(const Address &fad,uint4 flags)
 void ArchitectureGhidra::getBytes(uint1 *buf,int4 size,const Address &inaddr)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getBytes");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -693,6 +744,7 @@ void ArchitectureGhidra::getBytes(uint1 *buf,int4 size,const Address &inaddr)
 void ArchitectureGhidra::getStringData(vector<uint1> &buffer,const Address &addr,Datatype *ct,int4 maxBytes,bool &isTrunc)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getString");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -751,6 +803,7 @@ void ArchitectureGhidra::getStringData(vector<uint1> &buffer,const Address &addr
 Document *ArchitectureGhidra::getPcodeInject(const string &name,int4 type,const InjectContext &con)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   if (type == InjectPayload::CALLFIXUP_TYPE)
     writeStringStream(sout,"getCallFixup");
@@ -779,6 +832,7 @@ Document *ArchitectureGhidra::getPcodeInject(const string &name,int4 type,const
 Document *ArchitectureGhidra::getCPoolRef(const vector<uintb> &refs)
 
 {
+  numqueries += 1;
   sout.write("\000\000\001\004",4);
   writeStringStream(sout,"getCPoolRef");
   sout.write("\000\000\001\016",4); // Beginning of string header
@@ -839,6 +893,10 @@ ArchitectureGhidra::ArchitectureGhidra(const string &pspec,const string &cspec,c
   sendsyntaxtree = true;	// Default to sending everything
   sendCcode = true;
   sendParamMeasures = false;
+  sendpacked = false;
+  batchsymbols = false;
+  sendquerystats = false;
+  resetQueryCounts();
 }
 
 bool ArchitectureGhidra::isDynamicSymbolName(const string &nm)
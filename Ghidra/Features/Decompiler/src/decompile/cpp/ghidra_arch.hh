@@ -20,6 +20,7 @@
 #define __GHIDRA_ARCH__
 
 #include "architecture.hh"
+#include "packedxml.hh"
 
 /// \brief Exception that mirrors exceptions thrown by the Ghidra client
 ///
@@ -68,6 +69,12 @@ class ArchitectureGhidra : public Architecture {
   bool sendsyntaxtree;		///< True if the syntax tree should be sent with function output
   bool sendCcode;		///< True if C code should be sent with function output
   bool sendParamMeasures;       ///< True if measurements for argument and return parameters should be sent
+  bool sendpacked;		///< True if XML documents sent to the client should use the packed encoding
+  bool batchsymbols;		///< True if the client answers batched symbol queries
+  bool sendquerystats;		///< True if query counts are sent with each decompile result
+  uint4 numqueries;		///< Number of queries (round trips) sent to the client since the last reset
+  uint4 numsymbolqueries;	///< Number of single address symbol queries since the last reset
+  uint4 numbatchaddrs;		///< Number of addresses sent in batched symbol queries since the last reset
   virtual Scope *buildDatabase(DocumentStorage &store);
   virtual Translate *buildTranslator(DocumentStorage &store);
   virtual void buildLoader(DocumentStorage &store);
@@ -85,12 +92,17 @@ public:
   ArchitectureGhidra(const string &pspec,const string &cspec,const string &tspec,const string &corespec,istream &i,ostream &o);
   const string &getWarnings(void) const { return warnings; }	///< Get warnings produced by the last decompilation
   void clearWarnings(void) { warnings.clear(); }		///< Clear warnings
+  void resetQueryCounts(void) { numqueries = 0; numsymbolqueries = 0; numbatchaddrs = 0; }	///< Reset the query counts
+  uint4 getNumQueries(void) const { return numqueries; }	///< Get the number of round trips to the client since the last reset
+  uint4 getNumSymbolQueries(void) const { return numsymbolqueries; }	///< Get the number of single address symbol queries
+  uint4 getNumBatchAddresses(void) const { return numbatchaddrs; }	///< Get the number of addresses queried in batches
   Document *getRegister(const string &regname);			///< Retrieve a register description given a name
   string getRegisterName(const VarnodeData &vndata);		///< Retrieve a register name given its storage location
   Document *getTrackedRegisters(const Address &addr);		///< Retrieve \e tracked register values at the given address
   string getUserOpName(int4 index);				///< Get the name of a user-defined p-code op
   uint1 *getPcodePacked(const Address &addr);			///< Get p-code for a single instruction
   Document *getMappedSymbolsXML(const Address &addr);		///< Get symbols associated with the given address
+  Document *getMappedSymbolsBatchXML(const vector<Address> &addrlist);	///< Get symbols associated with many addresses at once
   Document *getExternalRefXML(const Address &addr);		///< Retrieve a description of an external function
   Document *getNamespacePath(uint8 id);				///< Get a description of a namespace path
   bool isNameUsed(const string &nm,uint8 startId,uint8 stopId);	///< Is given name used along namespace path
@@ -127,6 +139,32 @@ public:
 
   bool getSendParamMeasures(void) const { return sendParamMeasures; }	///< Get the current setting for emitting parameter info
 
+  /// \brief Toggle whether XML documents sent to the client use the packed encoding
+  ///
+  /// This is negotiated with the client when the program is registered. If the toggle is \b off,
+  /// documents are sent as XML text.
+  /// \param val is \b true to send packed documents
+  void setSendPacked(bool val) { sendpacked = val; }
+
+  bool getSendPacked(void) const { return sendpacked; }		///< Get the current setting for packed documents
+
+  /// \brief Toggle whether Symbols can be prefetched from the client in batched queries
+  ///
+  /// This is negotiated with the client when the program is registered. If the toggle is \b off,
+  /// Symbols are only fetched one address at a time.
+  /// \param val is \b true if the client answers batched queries
+  void setBatchSymbols(bool val) { batchsymbols = val; }
+
+  bool getBatchSymbols(void) const { return batchsymbols; }	///< Get whether the client answers batched queries
+
+  /// \brief Toggle whether query counts are sent with each decompile result
+  ///
+  /// This is negotiated with the client when the program is registered.
+  /// \param val is \b true to send a \<querystats> tag with each result
+  void setSendQueryStats(bool val) { sendquerystats = val; }
+
+  bool getSendQueryStats(void) const { return sendquerystats; }	///< Get whether query counts are sent with results
+
   virtual void getStringData(vector<uint1> &buffer,const Address &addr,Datatype *ct,int4 maxBytes,bool &isTrunc);
   virtual void printMessage(const string &message) const;
 
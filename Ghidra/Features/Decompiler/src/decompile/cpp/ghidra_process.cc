@@ -89,6 +89,7 @@ void GhidraCommand::loadParameters(void)
   if (ghidra == (ArchitectureGhidra *)0)
     throw JavaError("decompiler","No architecture registered with decompiler");
   ghidra->clearWarnings();
+  ghidra->resetQueryCounts();
 }
 
 /// This method sends any warnings accumulated during execution back, but it can be overloaded
@@ -155,10 +156,12 @@ void RegisterProgram::loadParameters(void)
   cspec.clear();
   tspec.clear();
   corespec.clear();
+  capabilities.clear();
   ArchitectureGhidra::readStringStream(sin,pspec);
   ArchitectureGhidra::readStringStream(sin,cspec);
   ArchitectureGhidra::readStringStream(sin,tspec);
   ArchitectureGhidra::readStringStream(sin,corespec);
+  ArchitectureGhidra::readStringStream(sin,capabilities);
 }
 
 
@@ -177,6 +180,22 @@ void RegisterProgram::rawAction(void)
 
   DocumentStorage store;	// temp storage of initialization xml docs
   ghidra->init(store);
+  packed = false;
+  batch = false;
+  stats = false;
+  istringstream s(capabilities);
+  string word;
+  while(s >> word) {
+    if (word == "packed")
+      packed = true;
+    else if (word == "batch")
+      batch = true;
+    else if (word == "stats")
+      stats = true;
+  }
+  ghidra->setSendPacked(packed);
+  ghidra->setBatchSymbols(batch);
+  ghidra->setSendQueryStats(stats);
   if (open == -1) {
     open = archlist.size();
     archlist.push_back((ArchitectureGhidra *)0);
@@ -190,6 +209,12 @@ void RegisterProgram::sendResult(void)
 {
   sout.write("\000\000\001\016",4);
   sout << dec << archid;
+  if (packed)
+    sout << " packed";
+  if (batch)
+    sout << " batch";
+  if (stats)
+    sout << " stats";
   sout.write("\000\000\001\017",4);
   GhidraCommand::sendResult();
 }
@@ -278,6 +303,38 @@ void DecompileAt::loadParameters(void)
   delete doc;
 }
 
+/// The document is written as XML text.  The source code is written through the
+/// print object, so its output stream must already be set to the same stream.
+/// \param fd is the decompiled function
+/// \param s is the stream to write to
+void DecompileAt::saveResult(Funcdata *fd,ostream &s)
+
+{
+  s << "<doc>\n";
+  if (ghidra->getSendParamMeasures() && (ghidra->allacts.getCurrentName() == "paramid")) {
+    ParamIDAnalysis pidanalysis( fd, true ); // Only send back final prototype
+    pidanalysis.saveXml( s, true );
+  }
+  else {
+    if (ghidra->getSendParamMeasures()) {
+      ParamIDAnalysis pidanalysis( fd, false );
+      pidanalysis.saveXml( s, true );
+    }
+    fd->saveXml(s,0,ghidra->getSendSyntaxTree());
+    if (ghidra->getSendCCode()&&
+	(ghidra->allacts.getCurrentName() == "decompile"))
+      ghidra->print->docFunction(fd);
+  }
+  if (ghidra->getSendQueryStats()) {	// Client round trips made by this command
+    s << "<querystats";
+    a_v_u(s,"queries",ghidra->getNumQueries());
+    a_v_u(s,"symbolqueries",ghidra->getNumSymbolQueries());
+    a_v_u(s,"batchaddrs",ghidra->getNumBatchAddresses());
+    s << "/>\n";
+  }
+  s << "</doc>\n";
+}
+
 void DecompileAt::rawAction(void) 
 
 {
@@ -299,34 +356,23 @@ void DecompileAt::rawAction(void)
   }
 
   sout.write("\000\000\001\016",4);
-				// Write output XML directly to outstream
   if (fd->isProcComplete()) {
-    //bool v1 = ghidra->getSendParamMeasures();
-    //sout << "value: " << ghidra->getSendParamMeasures() << "\n";
-    //bool v2 = (ghidra->allacts.getCurrentName() == "paramid");
-    //sout << "value: " << (ghidra->allacts.getCurrentName() == "paramid") << "\n";
-    //bool v3 = v1 && v2;
-
-    sout << "<doc>\n";
-    //sout << (v1?"1":"0") << "(" << (int4)v1 << ")\n" << (v2?"1":"0") << "\n" << (v3?"1":"0") << "\n";
-
-    if (ghidra->getSendParamMeasures() && (ghidra->allacts.getCurrentName() == "paramid")) {
-      ParamIDAnalysis pidanalysis( fd, true ); // Only send back final prototype
-      pidanalysis.saveXml( sout, true );
+    if (ghidra->getSendPacked()) {
+      ostringstream s;		// Collect the XML so it can be transcoded in one pass
+      ghidra->print->setOutputStream(&s);
+      saveResult(fd,s);
+      ghidra->print->setOutputStream(&sout);
+      string packed;
+      packed_transcode(s.str(),packed);
+      sout << packed;
     }
-    else {
-      if (ghidra->getSendParamMeasures()) {
-	ParamIDAnalysis pidanalysis( fd, false );
-	pidanalysis.saveXml( sout, true );
-      }
-      fd->saveXml(sout,0,ghidra->getSendSyntaxTree());
-      if (ghidra->getSendCCode()&&
-	  (ghidra->allacts.getCurrentName() == "decompile"))
-        ghidra->print->docFunction(fd);
-    }
-    sout << "</doc>\n";
+    else
+      saveResult(fd,sout);	// Write output XML directly to outstream
   }
   sout.write("\000\000\001\017",4);
+  // Results have been sent, release the syntax tree so a long running process doesn't
+  // hold onto the analysis of every function it has decompiled
+  ghidra->clearAnalysis(fd);
 }
 
 void StructureGraph::loadParameters(void)
@@ -510,6 +556,9 @@ int main(int argc,char **argv)
 
 {
   signal(SIGSEGV, &ArchitectureGhidra::segvHandler);  // Exit on SEGV errors
+  // All protocol traffic goes through cin/cout, and every message is explicitly flushed,
+  // so let the streams do their own buffering instead of a per-character stdio call
+  ios::sync_with_stdio(false);
   CapabilityPoint::initializeAll();
   int4 status = 0;
   while(status == 0) {
@@ -99,11 +99,23 @@ public:
 ///   - The compiler specification
 ///   - The stripped down \<sleigh> tag describing address spaces for the program
 ///   - The \<coretypes> tag describing the built-in datatypes for the program
+///
+/// followed by a space separated list of the capabilities the client supports:
+///   - \b packed if documents can be sent in the packed encoding, rather than as XML text
+///   - \b batch if the client answers batched getMappedSymbolsBatchXML queries
+///   - \b stats if the client accepts a \<querystats> tag in decompile results
+///
+/// The id is sent back followed by each capability that was accepted.  A client that lists
+/// none, such as "xml", gets XML text documents and single address queries only.
 class RegisterProgram : public GhidraCommand {
   string pspec;				///< Processor specification to configure with
   string cspec;				///< Compiler specification to configure with
   string tspec;				///< Configuration (address-spaces) for the Translate object
   string corespec;			///< A description of core data-types for the TypeFactory object
+  string capabilities;			///< Capabilities listed by the client
+  bool packed;				///< True if the packed encoding was accepted
+  bool batch;				///< True if batched symbol queries were accepted
+  bool stats;				///< True if query counts are sent with decompile results
   virtual void loadParameters(void);
   virtual void sendResult(void);
 public:
@@ -149,9 +161,15 @@ public:
 /// Symbols, data-types and p-code are fetched as needed from the client and cached in
 /// the Architecture object. XML Documents containing source code results, data-flow and
 /// control-flow structures, symbol information, etc., are sent back to the client.
+/// If the client negotiated the packed encoding, the document is sent packed.
+/// If the client negotiated query stats, the document ends with a \<querystats> tag counting
+/// the queries this command sent to the client.
+/// Once the results are sent, the analysis is cleared, so the process only holds the
+/// syntax tree of the function currently being decompiled.
 class DecompileAt : public GhidraCommand {
   Address addr;				///< The entry point address of the function to decompile
   virtual void loadParameters(void);
+  void saveResult(Funcdata *fd,ostream &s);	///< Write the decompiled function as an XML document
 public:
   virtual void rawAction(void);
 };
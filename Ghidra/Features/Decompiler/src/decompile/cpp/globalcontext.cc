@@ -509,22 +509,82 @@ void ContextInternal::saveXml(ostream &s) const
   s << "</context_points>\n";
 }
 
+/// \brief Restore a sequence of \<context_pointset> tags in one pass
+///
+/// Each point sets its variables from its address to the end of the database, later points
+/// overriding earlier ones. When the points are in increasing address order, as written by
+/// saveXml(), all split points are introduced first and the values are then painted in a single
+/// sweep, rather than with a separate split, lookup, and paint for every variable of every point.
+/// Otherwise each point is restored individually.
+/// \param points are the \<context_pointset> tags in document order
+/// \param manage is used to resolve address space references
+void ContextInternal::restorePoints(const vector<const Element *> &points,const AddrSpaceManager *manage)
+
+{
+  if (points.empty()) return;
+  vector<Address> addrs;
+  addrs.reserve(points.size());
+  bool sorted = true;
+  for(int4 i=0;i<points.size();++i) {
+    addrs.push_back(Address::restoreXml(points[i],manage));
+    if (i>0 && !(addrs[i-1] < addrs[i]))
+      sorted = false;
+  }
+  if (!sorted) {
+    for(int4 i=0;i<points.size();++i)
+      restoreContext(points[i],addrs[i],Address());
+    return;
+  }
+  for(int4 i=0;i<addrs.size();++i)
+    database.split(addrs[i]);
+  vector<pair<const ContextBitRange *,uintm> > active;	// Value currently painted for each variable
+  int4 pos = 0;
+  partmap<Address,FreeArray>::iterator iter = database.begin(addrs[0]);
+  for(;iter!=database.end();++iter) {
+    if ((pos < addrs.size())&&((*iter).first == addrs[pos])) {
+      const List &list(points[pos]->getChildren());
+      List::const_iterator liter;
+      for(liter=list.begin();liter!=list.end();++liter) {
+	const Element *subel = *liter;
+	const ContextBitRange *var = &getVariable(subel->getAttributeValue("name"));
+	uintm val = xml_readnumber(subel->getAttributeValue("val"));
+	int4 j;
+	for(j=0;j<active.size();++j)
+	  if (active[j].first == var) break;
+	if (j == active.size())
+	  active.push_back(pair<const ContextBitRange *,uintm>(var,val));
+	else
+	  active[j].second = val;
+      }
+      pos += 1;
+    }
+    uintm *context = (*iter).second.array;
+    uintm *maskPtr = (*iter).second.mask;
+    for(int4 j=0;j<active.size();++j) {
+      const ContextBitRange *var = active[j].first;
+      maskPtr[var->getWord()] |= var->getMask()<<var->getShift();	// Mark that this value is being definitely set
+      var->setValue(context,active[j].second);
+    }
+  }
+}
+
 void ContextInternal::restoreXml(const Element *el,const AddrSpaceManager *manage)
 
 {
   const List &list(el->getChildren());
   List::const_iterator iter = list.begin();
+  vector<const Element *> points;
 
   while(iter != list.end()) {
     const Element *subel = *iter;
     if (subel->getName() == "context_pointset") {
       if (subel->getNumAttributes()==0) {
+	restorePoints(points,manage);	// Keep points before the default in order
+	points.clear();
 	restoreContext(subel,Address(),Address());	// Restore the default value
       }
-      else {
-	Address addr = Address::restoreXml(subel,manage);
-	restoreContext(subel,addr,Address());
-      }
+      else
+	points.push_back(subel);	// Restored together
     }
     else if (subel->getName() == "tracked_pointset") {
       Address addr = Address::restoreXml(subel,manage);
@@ -534,6 +594,7 @@ void ContextInternal::restoreXml(const Element *el,const AddrSpaceManager *manag
       throw LowlevelError("Bad <context_points> tag: "+subel->getName());
     ++iter;
   }
+  restorePoints(points,manage);
 }
 
 void ContextInternal::restoreFromSpec(const Element *el,const AddrSpaceManager *manage)
@@ -571,23 +632,53 @@ ContextCache::ContextCache(ContextDatabase *db)
 
 {
   database = db;
-  curspace = (AddrSpace *)0;	// Mark cache as invalid
+  for(int4 i=0;i<numentries;++i)
+    invalidate(i);		// Mark cache as invalid
   allowset = true;
+  resetStatistics();
+}
+
+/// \param i is the index of the entry
+void ContextCache::invalidate(int4 i)
+
+{
+  entry[i].space = (AddrSpace *)0;
+  entry[i].first = 0;
+  entry[i].last = 0;
+  entry[i].context = (const uintm *)0;
 }
 
-/// Check if the address is in the current valid range. If it is, return the cached
-/// blob.  Otherwise, make a call to the database and cache a new block and valid range.
+/// Check if the address is in one of the cached valid ranges. If it is, return the cached
+/// blob.  Otherwise, make a call to the database and cache the new blob and valid range,
+/// replacing the least recently used entry.
 /// \param addr is the given address
 /// \param buf is where the blob should be stored
 void ContextCache::getContext(const Address &addr,uintm *buf) const
 
 {
-  if ((addr.getSpace()!=curspace)||(first>addr.getOffset())||(last<addr.getOffset())) {
-    curspace = addr.getSpace();
-    context = database->getContext(addr,first,last);
+  AddrSpace *spc = addr.getSpace();
+  uintb off = addr.getOffset();
+  count_lookup += 1;
+  int4 i;
+  for(i=0;i<numentries;++i) {
+    const Entry &cur(entry[i]);
+    if ((cur.space==spc)&&(cur.first<=off)&&(cur.last>=off)) break;
+  }
+  Entry found;
+  if (i < numentries) {
+    count_hit += 1;
+    found = entry[i];
   }
-  for(int4 i=0;i<database->getContextSize();++i) 
-    buf[i] = context[i];
+  else {
+    i = numentries - 1;		// Least recently used entry is replaced
+    found.space = spc;
+    found.context = database->getContext(addr,found.first,found.last);
+  }
+  for(;i>0;--i)			// Move the entry to the front
+    entry[i] = entry[i-1];
+  entry[0] = found;
+  for(int4 j=0;j<database->getContextSize();++j)
+    buf[j] = found.context[j];
 }
 
 /// \brief Change the value of a context variable at the given address with no bound
@@ -603,8 +694,11 @@ void ContextCache::setContext(const Address &addr,int4 num,uintm mask,uintm valu
 {
   if (!allowset) return;
   database->setContextChangePoint(addr,num,mask,value);
-  if ((addr.getSpace()==curspace)&&(first<=addr.getOffset())&&(last>=addr.getOffset()))
-    curspace = (AddrSpace *)0;	// Invalidate cache
+  for(int4 i=0;i<numentries;++i) {
+    const Entry &cur(entry[i]);
+    if ((addr.getSpace()==cur.space)&&(cur.first<=addr.getOffset())&&(cur.last>=addr.getOffset()))
+      invalidate(i);		// Range containing the change point has been split
+  }
 }
 
 /// \brief Change the value of a context variable across an explicit address range
@@ -621,11 +715,21 @@ void ContextCache::setContext(const Address &addr1,const Address &addr2,int4 num
 {
   if (!allowset) return;
   database->setContextRegion(addr1,addr2,num,mask,value);
-  if ((addr1.getSpace()==curspace)&&(first<=addr1.getOffset())&&(last>=addr1.getOffset()))
-    curspace = (AddrSpace *)0;	// Invalidate cache
-  if ((first<=addr2.getOffset())&&(last>=addr2.getOffset()))
-    curspace = (AddrSpace *)0;	// Invalidate cache
-  if ((first>=addr1.getOffset())&&(first<=addr2.getOffset()))
-    curspace = (AddrSpace *)0;	// Invalidate cache
+  for(int4 i=0;i<numentries;++i) {
+    const Entry &cur(entry[i]);
+    if (cur.space == (AddrSpace *)0) continue;
+    if ((addr1.getSpace()==cur.space)&&(cur.first<=addr1.getOffset())&&(cur.last>=addr1.getOffset()))
+      invalidate(i);
+    else if ((cur.first<=addr2.getOffset())&&(cur.last>=addr2.getOffset()))
+      invalidate(i);
+    else if ((cur.first>=addr1.getOffset())&&(cur.first<=addr2.getOffset()))
+      invalidate(i);
+  }
 }
 
+/// \param s is the stream to write to
+void ContextCache::printStatistics(ostream &s) const
+
+{
+  s << "Context cache: Lookups=" << dec << count_lookup << " Hits=" << count_hit << endl;
+}
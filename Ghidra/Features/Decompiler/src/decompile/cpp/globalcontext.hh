@@ -276,6 +276,7 @@ class ContextInternal : public ContextDatabase {
   partmap<Address,TrackedSet> trackbase;		///< Partition map of tracked register sets
   void saveContext(ostream &s,const Address &addr,const uintm *vec) const;
   void restoreContext(const Element *el,const Address &addr1,const Address &addr2);
+  void restorePoints(const vector<const Element *> &points,const AddrSpaceManager *manage);
   virtual ContextBitRange &getVariable(const string &nm);
   virtual const ContextBitRange &getVariable(const string &nm) const;
   virtual void getRegionForSet(vector<uintm *> &res,const Address &addr1,
@@ -303,16 +304,29 @@ public:
 
 /// \brief A helper class for caching the active context blob to minimize database lookups
 ///
-/// This merely caches the last retrieved context blob ("array of words") and the range of
-/// addresses over which the blob is valid.  It encapsulates the ContextDatabase itself and
-/// exposes a minimal interface (getContext() and setContext()).
+/// This caches the most recently retrieved context blobs ("array of words") together with
+/// the range of addresses over which each blob is valid. A handful of entries are kept, so that
+/// flow which alternates between a few regions with different context (e.g. interworking between
+/// instruction sets) does not fall back to the database on every switch. Entries are kept
+/// in most recently used order, and the least recently used one is replaced on a miss.
+/// It encapsulates the ContextDatabase itself and exposes a minimal interface (getContext() and setContext()).
 class ContextCache {
+  /// \brief A cached context blob and the range of addresses over which it is valid
+  struct Entry {
+    AddrSpace *space;		///< Address space of the valid range (null if the entry is empty)
+    uintb first;		///< Starting offset of the valid range
+    uintb last;			///< Ending offset of the valid range
+    const uintm *context;	///< The cached context blob
+  };
+  enum {
+    numentries = 4		///< Number of blobs that are cached
+  };
   ContextDatabase *database;		///< The encapsulated context database
   bool allowset;			///< If set to \b false, and setContext() call is dropped
-  mutable AddrSpace *curspace;		///< Address space of the current valid range
-  mutable uintb first;			///< Starting offset of the current valid range
-  mutable uintb last;			///< Ending offset of the current valid range
-  mutable const uintm *context;		///< The current cached context blob
+  mutable Entry entry[numentries];	///< Cached blobs, most recently used first
+  mutable uint4 count_lookup;		///< Number of getContext() calls
+  mutable uint4 count_hit;		///< Number of getContext() calls satisfied by the cache
+  void invalidate(int4 i);		///< Mark a single entry as empty
 public:
   ContextCache(ContextDatabase *db);	///< Construct given a context database
   ContextDatabase *getDatabase(void) const { return database; }		///< Retrieve the encapsulated database object
@@ -320,6 +334,8 @@ public:
   void getContext(const Address &addr,uintm *buf) const;	///< Retrieve the context blob for the given address
   void setContext(const Address &addr,int4 num,uintm mask,uintm value);
   void setContext(const Address &addr1,const Address &addr2,int4 num,uintm mask,uintm value);
+  void printStatistics(ostream &s) const;		///< Print lookup and hit counts
+  void resetStatistics(void) { count_lookup = 0; count_hit = 0; }	///< Reset lookup and hit counts
 };
 
 #endif
@@ -76,6 +76,7 @@ void IfaceDecompCapability::registerCommands(IfaceStatus *status)
   status->registerCom(new IfcGraphControlflow(),"graph","controlflow");
   status->registerCom(new IfcGraphDom(),"graph","dom");
   status->registerCom(new IfcPrintLanguage(),"print","language");
+  status->registerCom(new IfcPrintEditstats(),"print","editstats");
   status->registerCom(new IfcPrintCStruct(),"print","C");
   status->registerCom(new IfcPrintCFlat(),"print","C","flat");
   status->registerCom(new IfcPrintCGlobals(),"print","C","globals");
@@ -84,6 +85,11 @@ void IfaceDecompCapability::registerCommands(IfaceStatus *status)
   status->registerCom(new IfcPrintParamMeasures(),"print","parammeasures");
   status->registerCom(new IfcPrintParamMeasuresXml(),"print","parammeasures","xml");
   status->registerCom(new IfcProduceC(),"produce","C");
+  status->registerCom(new IfcCacheOpen(),"cache","open");
+  status->registerCom(new IfcCacheClose(),"cache","close");
+  status->registerCom(new IfcCacheStats(),"cache","stats");
+  status->registerCom(new IfcCacheVerify(),"cache","verify");
+  status->registerCom(new IfcPackedCheck(),"packed","check");
   status->registerCom(new IfcProducePrototypes(),"produce","prototypes");
   status->registerCom(new IfcPrintRaw(),"print","raw");
   status->registerCom(new IfcPrintInputs(),"print","inputs");
@@ -109,6 +115,11 @@ void IfaceDecompCapability::registerCommands(IfaceStatus *status)
   status->registerCom(new IfcPrintExtrapop(),"print","extrapop");
   status->registerCom(new IfcPrintActionstats(),"print","actionstats");
   status->registerCom(new IfcResetActionstats(),"reset","actionstats");
+  status->registerCom(new IfcPrintParserCachestats(),"print","parsercachestats");
+  status->registerCom(new IfcResetParserCachestats(),"reset","parsercachestats");
+  status->registerCom(new IfcPrintScopestats(),"print","scopestats");
+  status->registerCom(new IfcResetScopestats(),"reset","scopestats");
+  status->registerCom(new IfcPrintMergestats(),"print","mergestats");
   status->registerCom(new IfcCountPcode(),"count","pcode");
   status->registerCom(new IfcTypeVarnode(),"type","varnode");
   status->registerCom(new IfcNameVarnode(),"name","varnode");
@@ -124,6 +135,7 @@ void IfaceDecompCapability::registerCommands(IfaceStatus *status)
   status->registerCom(new IfcCallGraphDump(),"callgraph","dump");
   status->registerCom(new IfcCallGraphLoad(),"callgraph","load");
   status->registerCom(new IfcCallGraphList(),"callgraph","list");
+  status->registerCom(new IfcCallGraphSchedule(),"callgraph","schedule");
   status->registerCom(new IfcCallFixup(),"fixup","call");
   status->registerCom(new IfcCallOtherFixup(),"fixup","callother");
   status->registerCom(new IfcVolatile(),"volatile");
@@ -210,6 +222,14 @@ IfaceDecompData::IfaceDecompData(void)
   conf = (Architecture *)0;
   fd = (Funcdata *)0;
   cgraph = (CallGraph *)0;
+  resultcache = (ResultCache *)0;
+  editfd = (Funcdata *)0;
+  pendingedits = 0;
+  editconfig = 0;
+  for(int4 i=0;i<4;++i) {
+    editcount[i] = 0;
+    edittime[i] = 0.0;
+  }
 #ifdef OPACTION_DEBUG
   jumptabledebug = false;
 #endif
@@ -220,6 +240,8 @@ IfaceDecompData::~IfaceDecompData(void)
 {
   if (cgraph != (CallGraph *)0)
     delete cgraph;
+  if (resultcache != (ResultCache *)0)
+    delete resultcache;
   if (conf != (Architecture *)0)
     delete conf;
 // fd will get deleted with Database
@@ -233,22 +255,43 @@ void IfaceDecompData::allocateCallGraph(void)
   cgraph = new CallGraph(conf);
 }
 
+void IfaceDecompData::closeResultCache(void)
+
+{
+  if (resultcache != (ResultCache *)0)
+    delete resultcache;
+  resultcache = (ResultCache *)0;
+}
+
+void IfaceDecompData::recordEdit(uint4 kind)
+
+{ // Note an edit made to the current function, or to state it depends on
+  pendingedits |= kind;
+  if (kind != edit_cosmetic || fd != editfd)
+    editfd = (Funcdata *)0;	// Analysis can no longer be reused
+}
+
 void IfaceDecompData::abortFunction(ostream &s)
 
 {				// Clear references to current function
   if (fd == (Funcdata *)0) return;
   s << "Unable to proceed with function: " << fd->getName() << endl;
   conf->clearAnalysis(fd);
+  if (editfd == fd)
+    editfd = (Funcdata *)0;
   fd = (Funcdata *)0;
 }
 
 void IfaceDecompData::clearArchitecture(void)
 
 {
+  closeResultCache();		// Cache is tied to the Architecture
   if (conf != (Architecture *)0)
     delete conf;
   conf = (Architecture *)0;
   fd = (Funcdata *)0;
+  editfd = (Funcdata *)0;
+  pendingedits = 0;
 }
 
 void IfcComment::execute(istream &s)
@@ -318,6 +361,7 @@ void IfcParseFile::execute(istream &s)
     throw IfaceExecutionError("Bad C syntax");
   }
   fs.close();
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcParseLine::execute(istream &s)
@@ -337,6 +381,7 @@ void IfcParseLine::execute(istream &s)
     *status->optr << "Error in C syntax: " << err.explain << endl;
     throw IfaceExecutionError("Bad C syntax");
   }
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcAdjustVma::execute(istream &s)
@@ -439,6 +484,7 @@ void IfcReadSymbols::execute(istream &s)
     throw IfaceExecutionError("No binary loaded");
 
   dcp->conf->readLoaderSymbols("::");
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcMapaddress::execute(istream &s)
@@ -470,6 +516,7 @@ void IfcMapaddress::execute(istream &s)
     }
   }
 
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcMaphash::execute(istream &s)
@@ -489,6 +536,7 @@ void IfcMaphash::execute(istream &s)
 
   Symbol *sym = dcp->fd->getScopeLocal()->addDynamicSymbol(name,ct,addr,hash);
   sym->getScope()->setAttribute(sym,Varnode::namelock|Varnode::typelock);
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcMapfunction::execute(istream &s)
@@ -512,6 +560,7 @@ void IfcMapfunction::execute(istream &s)
   s >> ws >> nocode;
   if (nocode == "nocode")
     dcp->fd->setNoCode(true);
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcMapexternalref::execute(istream &s)
@@ -525,6 +574,7 @@ void IfcMapexternalref::execute(istream &s)
   s >> name;			// Read optional name
 
   dcp->conf->symboltab->getGlobalScope()->addExternalRef(addr1,addr2,name);
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcMaplabel::execute(istream &s)
@@ -545,6 +595,7 @@ void IfcMaplabel::execute(istream &s)
 
   Symbol *sym = scope->addCodeLabel(addr,name);
   scope->setAttribute(sym,Varnode::namelock|Varnode::typelock);
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcPrintdisasm::execute(istream &s)
@@ -627,24 +678,64 @@ void IfcDecompile::execute(istream &s)
     *status->optr << "No code for " << dcp->fd->getName() << endl;
     return;
   }
-  if (dcp->fd->isProcStarted()) { // Free up old decompile
-    *status->optr << "Clearing old decompilation" << endl;
-    dcp->conf->clearAnalysis(dcp->fd);
-  }
-    
-  *status->optr << "Decompiling " << dcp->fd->getName() << endl;
-  dcp->conf->allacts.getCurrent()->reset(*dcp->fd);
-  res = dcp->conf->allacts.getCurrent()->perform( *dcp->fd );
-  if (res<0) {
-    *status->optr << "Break at ";
-    dcp->conf->allacts.getCurrent()->printState(*status->optr);
+  clock_t start_time = clock();
+  int4 editclass;		// Most disruptive kind of edit since the last decompile
+  if ((dcp->pendingedits & IfaceDecompData::edit_flow)!=0)
+    editclass = 3;
+  else if ((dcp->pendingedits & IfaceDecompData::edit_type)!=0)
+    editclass = 2;
+  else if ((dcp->pendingedits & IfaceDecompData::edit_cosmetic)!=0)
+    editclass = 1;
+  else
+    editclass = 0;
+  uint4 confighash = dcp->conf->options->getConfigHash();
+  if (dcp->fd->isProcStarted() && dcp->editfd == dcp->fd &&
+      dcp->pendingedits == IfaceDecompData::edit_cosmetic && dcp->editconfig == confighash) {
+    // Only names or display formats have changed, which are read when printing
+    *status->optr << "Keeping analysis of " << dcp->fd->getName() << " (only names or formats changed)" << endl;
+    res = 1;
   }
   else {
-    *status->optr << "Decompilation complete";
-    if (res==0)
-      *status->optr << " (no change)";
+    if (dcp->fd->isProcStarted()) { // Free up old decompile
+      *status->optr << "Clearing old decompilation" << endl;
+      dcp->conf->clearAnalysis(dcp->fd);
+    }
+
+    *status->optr << "Decompiling " << dcp->fd->getName() << endl;
+    dcp->conf->allacts.getCurrent()->reset(*dcp->fd);
+    res = dcp->conf->allacts.getCurrent()->perform( *dcp->fd );
+    if (res<0) {
+      *status->optr << "Break at ";
+      dcp->conf->allacts.getCurrent()->printState(*status->optr);
+    }
+    else {
+      *status->optr << "Decompilation complete";
+      if (res==0)
+	*status->optr << " (no change)";
+    }
+    *status->optr << endl;
+  }
+  clock_t end_time = clock();
+  dcp->editcount[editclass] += 1;
+  dcp->edittime[editclass] += ((float)(end_time - start_time))*1000.0/CLOCKS_PER_SEC;
+  dcp->pendingedits = 0;
+  dcp->editfd = (res >= 0) ? dcp->fd : (Funcdata *)0;	// Only completed analysis can be reused
+  dcp->editconfig = confighash;
+}
+
+void IfcPrintEditstats::execute(istream &s)
+
+{				// Print decompile times grouped by the kind of edit preceding them
+  static const char *classname[] = { "none", "cosmetic", "type", "flow" };
+
+  *status->optr << "Decompiles by preceding edit:" << endl;
+  for(int4 i=0;i<4;++i) {
+    *status->optr << "  " << classname[i] << ": Count=" << dcp->editcount[i];
+    *status->optr << " Total=" << dcp->edittime[i] << "ms";
+    if (dcp->editcount[i] != 0)
+      *status->optr << " Average=" << dcp->edittime[i] / dcp->editcount[i] << "ms";
+    *status->optr << endl;
   }
-  *status->optr << endl;
 }
 
 void IfcPrintCFlat::execute(istream &s)
@@ -777,6 +868,7 @@ void IfcSetcontextrange::execute(istream &s)
 {
   if (dcp->conf == (Architecture *)0)
     throw IfaceExecutionError("No load image present");
+  dcp->recordEdit(IfaceDecompData::edit_type);
 
   string name;
   s >> name >> ws;
@@ -815,6 +907,7 @@ void IfcSettrackedrange::execute(istream &s)
 {
   if (dcp->conf == (Architecture *)0)
     throw IfaceExecutionError("No load image present");
+  dcp->recordEdit(IfaceDecompData::edit_type);
 
   string name;
   s >> name >> ws;
@@ -1012,10 +1105,24 @@ void IfcRename::execute(istream &s)
   else
     throw IfaceExecutionError("More than one symbol named: "+oldname);
 
+  // Renaming a parameter locks the prototype, and renaming anything locks its data-type,
+  // either of which can change analysis.  A name already in use in the symbol's scope, in
+  // the function's local scope, or in the global scope, forces names to be deduplicated or qualified.
+  // Otherwise only the printed name changes.
+  bool cosmetic = (sym->getCategory() != 0 && sym->isTypeLocked());
+  if (cosmetic && newname != sym->getName()) {
+    if (sym->getScope()->isNameUsed(newname,(const Scope *)0))
+      cosmetic = false;
+    else if (dcp->fd != (Funcdata *)0 && dcp->fd->getScopeLocal()->isNameUsed(newname,(const Scope *)0))
+      cosmetic = false;
+    else if (dcp->conf->symboltab->getGlobalScope()->isNameUsed(newname,(const Scope *)0))
+      cosmetic = false;
+  }
   if (sym->getCategory() == 0)
     dcp->fd->getFuncProto().setInputLock(true);
   sym->getScope()->renameSymbol(sym,newname);
   sym->getScope()->setAttribute(sym,Varnode::namelock|Varnode::typelock);
+  dcp->recordEdit(cosmetic ? IfaceDecompData::edit_cosmetic : IfaceDecompData::edit_type);
 }
 
 void IfcRemove::execute(istream &s)
@@ -1038,6 +1145,7 @@ void IfcRemove::execute(istream &s)
   if (symList.size() > 1)
     throw IfaceExecutionError("More than one symbol named: "+name);
   symList[0]->getScope()->removeSymbol(symList[0]);
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcRetype::execute(istream &s)
@@ -1073,6 +1181,7 @@ void IfcRetype::execute(istream &s)
     sym->getScope()->renameSymbol(sym,newname);
     sym->getScope()->setAttribute(sym,Varnode::namelock);
   }
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
   
 static Varnode *iface_read_varnode(IfaceDecompData *dcp,istream &s)
@@ -1264,6 +1373,7 @@ void IfcNameVarnode::execute(istream &s)
 
   *status->fileoptr << "Successfully added " << token;
   *status->fileoptr << " to scope " << scope->getFullName() << endl;
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcTypeVarnode::execute(istream &s)
@@ -1294,6 +1404,7 @@ void IfcTypeVarnode::execute(istream &s)
   
   *status->fileoptr << "Successfully added " << sym->getName();
   *status->fileoptr << " to scope " << scope->getFullName() << endl;
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 static Varnode *find_varnode_via_op(istream &s,Funcdata *fd,const TypeFactory &typegrp)
@@ -1340,6 +1451,7 @@ void IfcForceHex::execute(istream &s)
   sym->getScope()->setDisplayFormat(sym,Symbol::force_hex);
   sym->getScope()->setAttribute(sym,Varnode::typelock);
   *status->optr << "Successfully forced hex display" << endl;
+  dcp->recordEdit(IfaceDecompData::edit_cosmetic);
 }
 
 void IfcForceDec::execute(istream &s)
@@ -1361,6 +1473,7 @@ void IfcForceDec::execute(istream &s)
   sym->getScope()->setDisplayFormat(sym,Symbol::force_dec);
   sym->getScope()->setAttribute(sym,Varnode::typelock);
   *status->optr << "Successfully forced dec display" << endl;
+  dcp->recordEdit(IfaceDecompData::edit_cosmetic);
 }
 
 void IfcForcegoto::execute(istream &s)
@@ -1373,6 +1486,7 @@ void IfcForcegoto::execute(istream &s)
   s >> ws;
   Address dest(parse_machaddr(s,discard,*dcp->conf->types));
   dcp->fd->getOverride().insertForceGoto(target,dest);
+  dcp->recordEdit(IfaceDecompData::edit_flow);
 }
 
 void IfcProtooverride::execute(istream &s)
@@ -1401,6 +1515,7 @@ void IfcProtooverride::execute(istream &s)
   newproto->setPieces(pieces);
   dcp->fd->getOverride().insertProtoOverride(callpoint,newproto);
   dcp->fd->clear();		// Clear any analysis (this leaves overrides intact)
+  dcp->recordEdit(IfaceDecompData::edit_flow);
 }
 
 void IfcJumpOverride::execute(istream &s)
@@ -1442,6 +1557,7 @@ void IfcJumpOverride::execute(istream &s)
     throw IfaceExecutionError("Missing jumptable address entries");
   jt->setOverride(adtable,naddr,h,sv);
   *status->optr << "Successfully installed jumptable override" << endl;
+  dcp->recordEdit(IfaceDecompData::edit_flow);
 }
 
 void IfcFlowOverride::execute(istream &s)
@@ -1465,6 +1581,7 @@ void IfcFlowOverride::execute(istream &s)
 
   dcp->fd->getOverride().insertFlowOverride(addr,type);
   *status->optr << "Successfully added override" << endl;
+  dcp->recordEdit(IfaceDecompData::edit_flow);
 }
 
 void IfcDeadcodedelay::execute(istream &s)
@@ -1491,6 +1608,7 @@ void IfcDeadcodedelay::execute(istream &s)
     dcp->conf->setDeadcodeDelay(spc,delay);
     *status->optr << "Successfully overrided deadcode delay for all functions" << endl;
   }
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcGlobalAdd::execute(istream &s)
@@ -1506,6 +1624,7 @@ void IfcGlobalAdd::execute(istream &s)
 
   Scope *scope = dcp->conf->symboltab->getGlobalScope();
   dcp->conf->symboltab->addRange(scope,addr.getSpace(),first,last);
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcGlobalRemove::execute(istream &s)
@@ -1521,6 +1640,7 @@ void IfcGlobalRemove::execute(istream &s)
 
   Scope *scope = dcp->conf->symboltab->getGlobalScope();
   dcp->conf->symboltab->removeRange(scope,addr.getSpace(),first,last);
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcGlobalify::execute(istream &s)
@@ -1530,6 +1650,7 @@ void IfcGlobalify::execute(istream &s)
     throw IfaceExecutionError("No load image present");
   dcp->conf->globalify();
   *status->optr << "Successfully made all registers/memory locations global" << endl;
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcGlobalRegisters::execute(istream &s)
@@ -1565,6 +1686,7 @@ void IfcGlobalRegisters::execute(istream &s)
     *status->optr << "No global registers" << endl;
   else
     *status->optr << "Successfully made a global symbol for " << count << " registers" << endl;
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 static bool nontrivial_use(Varnode *vn)
@@ -1752,6 +1874,7 @@ void IfcLockPrototype::execute(istream &s)
 
   dcp->fd->getFuncProto().setInputLock(true);
   dcp->fd->getFuncProto().setOutputLock(true);
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcUnlockPrototype::execute(istream &s)
@@ -1762,6 +1885,7 @@ void IfcUnlockPrototype::execute(istream &s)
 
   dcp->fd->getFuncProto().setInputLock(false);
   dcp->fd->getFuncProto().setOutputLock(false);
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcPrintLocalrange::execute(istream &s)
@@ -1806,7 +1930,24 @@ void IfcProduceC::execute(istream &s)
   s >> ws >> name;
   if (name.size()==0)
     throw IfaceParseError("Need file name to write to");
-  
+
+  // Optionally restrict output to one partition of the functions, so that
+  // independent console processes can split a large image between them
+  slice = 0;
+  numslices = 1;
+  count = 0;
+  s >> ws;
+  if (!s.eof()) {
+    s >> dec >> slice;
+    if (s.fail())
+      throw IfaceParseError("Bad partition index");
+    s >> ws >> numslices;
+    if (s.fail())
+      throw IfaceParseError("Missing partition count");
+    if (numslices < 1 || slice < 0 || slice >= numslices)
+      throw IfaceParseError("Bad partition: need <index> <count> with 0 <= index < count");
+  }
+
   ofstream os;
   os.open(name.c_str());
   dcp->conf->print->setOutputStream(&os);
@@ -1822,12 +1963,24 @@ void IfcProduceC::iterationCallback(Funcdata *fd)
   clock_t start_time,end_time;
   float duration;
 
+  int4 index = count++;
+  if ((index % numslices) != slice) return; // Function belongs to a different partition
   if (fd->hasNoCode()) {
     *status->optr << "No code for " << fd->getName() << endl;
     return;
   }
   try {
     dcp->conf->clearAnalysis(fd); // Clear any old analysis
+    uint8 inputhash = 0;
+    if (dcp->resultcache != (ResultCache *)0) {
+      inputhash = dcp->resultcache->hashInputs(fd);
+      const string *text = dcp->resultcache->lookup(fd,inputhash);
+      if (text != (const string *)0) {
+	*status->optr << "Cached " << fd->getName() << endl;
+	*dcp->conf->print->getOutputStream() << *text;
+	return;
+      }
+    }
     dcp->conf->allacts.getCurrent()->reset(*fd);
     start_time = clock();
     dcp->conf->allacts.getCurrent()->perform( *fd );
@@ -1838,14 +1991,174 @@ void IfcProduceC::iterationCallback(Funcdata *fd)
     duration = ((float)(end_time-start_time))/CLOCKS_PER_SEC;
     duration *= 1000.0;
     *status->optr << " time=" << fixed << setprecision(0) << duration << " ms" << endl;
+    if (dcp->resultcache != (ResultCache *)0) {
+      ostream *os = dcp->conf->print->getOutputStream();
+      ostringstream text;
+      dcp->conf->print->setOutputStream(&text);
+      try {
+	dcp->conf->print->docFunction(fd);
+      }
+      catch(LowlevelError &err) {
+	dcp->conf->print->setOutputStream(os);
+	throw;
+      }
+      dcp->conf->print->setOutputStream(os);
+      *os << text.str();
+      dcp->resultcache->store(fd,inputhash,text.str());
+    }
+    else
+      dcp->conf->print->docFunction(fd);
+  }
+  catch(LowlevelError &err) {
+    *status->optr << "Skipping " << fd->getName() << ": " << err.explain << endl;
+  }
+  dcp->conf->clearAnalysis(fd);
+}
+
+void IfcCacheOpen::execute(istream &s)
+
+{ // Attach a persistent cache of "produce C" output, backed by the given file
+  string name;
+
+  if (dcp->conf == (Architecture *)0)
+    throw IfaceExecutionError("No load image");
+  s >> ws >> name;
+  if (name.size()==0)
+    throw IfaceParseError("Need name of cache file");
+  dcp->closeResultCache();
+  dcp->resultcache = new ResultCache(dcp->conf,name);
+  *status->optr << "Opened result cache " << name << " with " << dec << dcp->resultcache->numRecords() << " records" << endl;
+}
+
+void IfcCacheClose::execute(istream &s)
+
+{
+  if (dcp->resultcache == (ResultCache *)0)
+    throw IfaceExecutionError("No result cache open");
+  dcp->closeResultCache();
+}
+
+void IfcCacheStats::execute(istream &s)
+
+{
+  if (dcp->resultcache == (ResultCache *)0)
+    throw IfaceExecutionError("No result cache open");
+  dcp->resultcache->printStatistics(*status->fileoptr);
+}
+
+void IfcCacheVerify::execute(istream &s)
+
+{ // Decompile every function with valid cached output and compare against the cache
+  if (dcp->resultcache == (ResultCache *)0)
+    throw IfaceExecutionError("No result cache open");
+  numchecked = 0;
+  nummismatch = 0;
+  iterateFunctionsAddrOrder();
+  *status->optr << "Checked " << dec << numchecked << " cached functions, " << nummismatch << " mismatches" << endl;
+}
+
+void IfcCacheVerify::iterationCallback(Funcdata *fd)
+
+{
+  if (fd->hasNoCode()) return;
+  ostream *os = dcp->conf->print->getOutputStream();
+  try {
+    dcp->conf->clearAnalysis(fd); // Clear any old analysis
+    const string *cached = dcp->resultcache->peek(fd,dcp->resultcache->hashInputs(fd));
+    if (cached == (const string *)0) return;
+    dcp->conf->allacts.getCurrent()->reset(*fd);
+    dcp->conf->allacts.getCurrent()->perform( *fd );
+    ostringstream text;
+    dcp->conf->print->setOutputStream(&text);
     dcp->conf->print->docFunction(fd);
+    numchecked += 1;
+    if (text.str() != *cached) {
+      nummismatch += 1;
+      *status->optr << "Mismatch for " << fd->getName() << endl;
+    }
   }
   catch(LowlevelError &err) {
     *status->optr << "Skipping " << fd->getName() << ": " << err.explain << endl;
   }
+  dcp->conf->print->setOutputStream(os);
   dcp->conf->clearAnalysis(fd);
 }
 
+bool IfcPackedCheck::sameElement(const Element *a,const Element *b,ostream &s)
+
+{ // Compare two DOM trees, reporting the path to the first difference
+  bool same = (a->getName() == b->getName() && a->getContent() == b->getContent());
+  if (same && a->getNumAttributes() == b->getNumAttributes()) {
+    for(int4 i=0;i<a->getNumAttributes();++i) {
+      if (a->getAttributeName(i) != b->getAttributeName(i) || a->getAttributeValue(i) != b->getAttributeValue(i)) {
+	same = false;
+	break;
+      }
+    }
+  }
+  else
+    same = false;
+  const List &alist(a->getChildren());
+  const List &blist(b->getChildren());
+  if (same && alist.size() == blist.size()) {
+    List::const_iterator aiter = alist.begin();
+    List::const_iterator biter = blist.begin();
+    for(;aiter!=alist.end();++aiter,++biter) {
+      if (!sameElement(*aiter,*biter,s)) {
+	s << " in <" << a->getName() << '>';
+	return false;
+      }
+    }
+    return true;
+  }
+  s << "Difference at <" << a->getName() << '>';
+  return false;
+}
+
+void IfcPackedCheck::execute(istream &s)
+
+{ // Check that each XML file decodes to the same tree from its packed encoding
+  int4 numfiles = 0;
+  int4 numbad = 0;
+  for(;;) {
+    string filename;
+    s >> ws >> filename;
+    if (filename.empty()) break;
+    ifstream fs(filename.c_str());
+    if (!fs)
+      throw IfaceExecutionError("Unable to open file: "+filename);
+    string xml((istreambuf_iterator<char>(fs)),istreambuf_iterator<char>());
+    fs.close();
+    numfiles += 1;
+    Document *expected = (Document *)0;
+    Document *actual = (Document *)0;
+    try {
+      expected = xml_tree(xml);
+      string packed;
+      packed_transcode(xml,packed);
+      if (packed.find('\0') != string::npos)
+	throw XmlError("Packed encoding contains a zero byte");
+      actual = packed_tree(packed);
+      ostringstream diff;
+      if (sameElement(expected->getRoot(),actual->getRoot(),diff))
+	*status->optr << filename << ": " << dec << xml.size() << " -> " << packed.size() << " bytes" << endl;
+      else {
+	numbad += 1;
+	*status->optr << filename << ": " << diff.str() << endl;
+      }
+    }
+    catch(XmlError &err) {
+      numbad += 1;
+      *status->optr << filename << ": " << err.explain << endl;
+    }
+    delete expected;
+    delete actual;
+  }
+  if (numfiles == 0)
+    throw IfaceParseError("Need at least one XML file to check");
+  *status->optr << "Checked " << dec << numfiles << " files, " << numbad << " failures" << endl;
+}
+
 void IfcProducePrototypes::execute(istream &s)
 
 {  // Walk callgraph in leaf-first order, calculate prototype
@@ -2010,6 +2323,7 @@ void IfcCommentInstr::execute(istream &s)
   uint4 type = dcp->conf->print->getInstructionComment();
   dcp->conf->commentdb->addComment(type,
 				  dcp->fd->getAddress(),addr,comment);
+  dcp->recordEdit(IfaceDecompData::edit_cosmetic);
 }
 
 static void duplicate_hash(Funcdata *fd,ostream &s)
@@ -2227,6 +2541,122 @@ void IfcCallGraphLoad::execute(istream &s)
   *status->optr << "Successfully associated functions with callgraph nodes" << endl;
 }
 
+void IfcCallGraphSchedule::execute(istream &s)
+
+{ // Decompile leaf-first, one call graph level at a time, then report the schedule
+  int4 workers = 1;
+
+  if (dcp->conf == (Architecture *)0)
+    throw IfaceExecutionError("No load image");
+  if (dcp->cgraph == (CallGraph *)0)
+    throw IfaceExecutionError("Callgraph has not been built");
+  s >> ws;
+  if (!s.eof()) {
+    s >> dec >> workers;
+    if (workers <= 0)
+      throw IfaceParseError("Bad number of workers");
+  }
+
+  vector<vector<CallGraphNode *> > levels;
+  dcp->cgraph->buildLevels(levels);
+  durations.clear();
+  int4 count = 0;
+  for(int4 i=0;i<levels.size();++i) {
+    for(int4 j=0;j<levels[i].size();++j) {
+      if (decompileNode(levels[i][j]))
+	count += 1;
+    }
+  }
+  *status->optr << "Decompiled " << dec << count << " functions in " << levels.size() << " levels" << endl;
+  printSchedule(levels,workers);
+}
+
+bool IfcCallGraphSchedule::decompileNode(CallGraphNode *node)
+
+{ // Decompile one function and record its time. The recovered prototype model is
+  // locked so that callers, which are decompiled later, see it.
+  clock_t start_time,end_time;
+  float duration;
+
+  durations[node] = 0.0;
+  Funcdata *fd = node->getFuncdata();
+  if (fd == (Funcdata *)0 || fd->hasNoCode())
+    return false;
+  bool res = false;
+  try {
+    dcp->conf->clearAnalysis(fd); // Clear any old analysis
+    dcp->conf->allacts.getCurrent()->reset(*fd);
+    start_time = clock();
+    dcp->conf->allacts.getCurrent()->perform( *fd );
+    end_time = clock();
+    if (!fd->getFuncProto().isInputLocked())
+      fd->getFuncProto().setModelLock(true);
+    duration = ((float)(end_time-start_time))/CLOCKS_PER_SEC;
+    duration *= 1000.0;
+    durations[node] = duration;
+    res = true;
+  }
+  catch(LowlevelError &err) {
+    *status->optr << "Skipping " << fd->getName() << ": " << err.explain << endl;
+  }
+  dcp->conf->clearAnalysis(fd);
+  return res;
+}
+
+void IfcCallGraphSchedule::printSchedule(const vector<vector<CallGraphNode *> > &levels,int4 workers)
+
+{ // The critical path is the most expensive chain of calls, which bounds the finish time for
+  // any number of workers. The pool estimate hands functions, in decompile order, to whichever
+  // worker is free first, but starts no function before all its callees have finished.
+  map<CallGraphNode *,float> pathtime;		// Longest chain of callees ending at each node
+  map<CallGraphNode *,float> finish;		// Finish time of each node in the pool estimate
+  vector<float> freetime(workers,0.0);		// Time at which each worker becomes free
+  float total = 0.0;
+  float critical = 0.0;
+  float makespan = 0.0;
+
+  for(int4 i=0;i<levels.size();++i) {
+    for(int4 j=0;j<levels[i].size();++j) {
+      CallGraphNode *node = levels[i][j];
+      float dur = durations[node];
+      float longest = 0.0;
+      float ready = 0.0;
+      for(int4 k=0;k<node->numOutEdge();++k) {
+	if (node->getOutEdge(k).isCycle()) continue;
+	CallGraphNode *callee = node->getOutNode(k);
+	if (pathtime[callee] > longest)
+	  longest = pathtime[callee];
+	if (finish[callee] > ready)
+	  ready = finish[callee];
+      }
+      pathtime[node] = longest + dur;
+      if (longest + dur > critical)
+	critical = longest + dur;
+      int4 w = 0;
+      for(int4 k=1;k<workers;++k) {
+	if (freetime[k] < freetime[w])
+	  w = k;
+      }
+      float start = (freetime[w] > ready) ? freetime[w] : ready;
+      finish[node] = start + dur;
+      freetime[w] = start + dur;
+      if (start + dur > makespan)
+	makespan = start + dur;
+      total += dur;
+    }
+  }
+  ostream &s( *status->optr );
+  s << "Levels:";
+  for(int4 i=0;i<levels.size();++i)
+    s << ' ' << dec << levels[i].size();
+  s << endl;
+  s << fixed << setprecision(0);
+  s << "Total decompile time: " << total << " ms" << endl;
+  s << "Critical path: " << critical << " ms" << endl;
+  s << "Estimated time with " << dec << workers << " workers: " << makespan << " ms" << endl;
+  s << "Estimated worker idle time: " << (makespan * workers - total) << " ms" << endl;
+}
+
 void IfcCallGraphList::execute(istream &s)
 
 { // List all functions in leaf-first order
@@ -2282,6 +2712,7 @@ void IfcCallFixup::execute(istream &s)
   }
   InjectPayload *payload = dcp->conf->pcodeinjectlib->getPayload(id);
   payload->printTemplate(*status->optr);
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcCallOtherFixup::execute(istream &s)
@@ -2294,6 +2725,7 @@ void IfcCallOtherFixup::execute(istream &s)
   dcp->conf->userops.manualCallOtherFixup(useropname,outname,inname,pcodestring,dcp->conf);
 
   *status->optr << "Successfully registered callotherfixup" << endl;
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcVolatile::execute(istream &s)
@@ -2310,6 +2742,7 @@ void IfcVolatile::execute(istream &s)
   dcp->conf->symboltab->setPropertyRange(Varnode::volatil,range);
 
   *status->optr << "Successfully marked range as volatile" << endl;
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcReadonly::execute(istream &s)
@@ -2326,6 +2759,7 @@ void IfcReadonly::execute(istream &s)
   dcp->conf->symboltab->setPropertyRange(Varnode::readonly,range);
 
   *status->optr << "Successfully marked range as readonly" << endl;
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcPreferSplit::execute(istream &s)
@@ -2354,6 +2788,7 @@ void IfcPreferSplit::execute(istream &s)
   rec.splitoffset = split;
 
   *status->optr << "Successfully added split record" << endl;
+  dcp->recordEdit(IfaceDecompData::edit_type);
 }
 
 void IfcStructureBlocks::execute(istream &s)
@@ -2470,6 +2905,15 @@ void IfcPrintActionstats::execute(istream &s)
   dcp->conf->allacts.getCurrent()->printStatistics(*status->fileoptr);
 }
 
+void IfcPrintMergestats::execute(istream &s)
+
+{
+  if (dcp->fd == (Funcdata *)0)
+    throw IfaceExecutionError("No function selected");
+
+  dcp->fd->getMerge().getTestCache().printStatistics(*status->fileoptr);
+}
+
 void IfcResetActionstats::execute(istream &s)
 
 {
@@ -2481,6 +2925,36 @@ void IfcResetActionstats::execute(istream &s)
   dcp->conf->allacts.getCurrent()->resetStats();
 }
 
+void IfcPrintParserCachestats::execute(istream &s)
+
+{
+  if (dcp->conf == (Architecture *)0)
+    throw IfaceExecutionError("Image not loaded");
+
+  dcp->conf->translate->printParserCacheStatistics(*status->fileoptr);
+}
+
+void IfcResetParserCachestats::execute(istream &s)
+
+{
+  if (dcp->conf == (Architecture *)0)
+    throw IfaceExecutionError("Image not loaded");
+
+  dcp->conf->translate->resetParserCacheStatistics();
+}
+
+void IfcPrintScopestats::execute(istream &s)
+
+{
+  Database::lookupstats.print(*status->fileoptr);
+}
+
+void IfcResetScopestats::execute(istream &s)
+
+{
+  Database::lookupstats.reset();
+}
+
 void IfcCountPcode::execute(istream &s)
 
 {
@@ -23,6 +23,8 @@
 #include "grammar.hh"
 #include "callgraph.hh"
 #include "paramid.hh"
+#include "resultcache.hh"
+#include "packedxml.hh"
 #ifdef CPUI_RULECOMPILE
 #include "rulecompile.hh"
 #endif
@@ -41,6 +43,17 @@ public:
   Funcdata *fd;		// Current function data
   Architecture *conf;
   CallGraph *cgraph;
+  ResultCache *resultcache;	// Cache of output from "produce C", if open
+  enum {
+    edit_cosmetic = 1,		// Edit only changes how the function is printed
+    edit_type = 2,		// Edit changes data-types, prototypes or symbols
+    edit_flow = 4		// Edit changes control-flow or call overrides
+  };
+  Funcdata *editfd;		// Function whose completed analysis can be reused, if any
+  uint4 pendingedits;		// Kinds of edit made since the last decompile
+  uint4 editconfig;		// Option configuration hash at the last decompile
+  int4 editcount[4];		// Number of decompiles by edit class: none, cosmetic, type, flow
+  float edittime[4];		// Time (in ms) spent decompiling by edit class
 
   map<Funcdata*,PrototypePieces> prototypePieces;
   void storePrototypePieces( Funcdata *fd_in, PrototypePieces pp_in ) { prototypePieces.insert(pair<Funcdata*,PrototypePieces>(fd_in,pp_in)); }
@@ -55,6 +68,8 @@ public:
   IfaceDecompData(void);
   virtual ~IfaceDecompData(void);
   void allocateCallGraph(void);
+  void closeResultCache(void);
+  void recordEdit(uint4 kind);
   void abortFunction(ostream &s);
   void clearArchitecture(void);
 };
@@ -180,6 +195,11 @@ public:
   virtual void execute(istream &s);
 };
 
+class IfcPrintEditstats : public IfaceDecompCommand {
+public:
+  virtual void execute(istream &s);
+};
+
 class IfcPrintLanguage : public IfaceDecompCommand {
 public:
   virtual void execute(istream &s);
@@ -211,11 +231,44 @@ public:
 };
 
 class IfcProduceC : public IfaceDecompCommand {
+  int4 slice;			// Index of the partition this command decompiles
+  int4 numslices;		// Number of partitions the function list is split into
+  int4 count;			// Number of functions visited by the current iteration
 public:
+  IfcProduceC(void) { slice = 0; numslices = 1; count = 0; }
   virtual void execute(istream &s);
   virtual void iterationCallback(Funcdata *fd);
 };
 
+class IfcCacheOpen : public IfaceDecompCommand {
+public:
+  virtual void execute(istream &s);
+};
+
+class IfcCacheClose : public IfaceDecompCommand {
+public:
+  virtual void execute(istream &s);
+};
+
+class IfcCacheStats : public IfaceDecompCommand {
+public:
+  virtual void execute(istream &s);
+};
+
+class IfcCacheVerify : public IfaceDecompCommand {
+  int4 numchecked;		// Number of cached functions compared against a fresh decompile
+  int4 nummismatch;		// Number of cached functions whose output differed
+public:
+  virtual void execute(istream &s);
+  virtual void iterationCallback(Funcdata *fd);
+};
+
+class IfcPackedCheck : public IfaceDecompCommand {
+  static bool sameElement(const Element *a,const Element *b,ostream &s);
+public:
+  virtual void execute(istream &s);
+};
+
 class IfcProducePrototypes : public IfaceDecompCommand {
 public:
   virtual void execute(istream &s);
@@ -489,6 +542,14 @@ public:
   virtual void execute(istream &s);
 };
 
+class IfcCallGraphSchedule : public IfaceDecompCommand {
+  map<CallGraphNode *,float> durations;	// Decompile time (in ms) of each function
+  bool decompileNode(CallGraphNode *node);
+  void printSchedule(const vector<vector<CallGraphNode *> > &levels,int4 workers);
+public:
+  virtual void execute(istream &s);
+};
+
 class IfcCallGraphList : public IfaceDecompCommand {
 protected:
   bool quick;
@@ -522,11 +583,36 @@ public:
   virtual void execute(istream &s);
 };
 
+class IfcPrintMergestats : public IfaceDecompCommand {
+public:
+  virtual void execute(istream &s);
+};
+
 class IfcResetActionstats : public IfaceDecompCommand {
 public:
   virtual void execute(istream &s);
 };
 
+class IfcPrintParserCachestats : public IfaceDecompCommand {
+public:
+  virtual void execute(istream &s);
+};
+
+class IfcResetParserCachestats : public IfaceDecompCommand {
+public:
+  virtual void execute(istream &s);
+};
+
+class IfcPrintScopestats : public IfaceDecompCommand {
+public:
+  virtual void execute(istream &s);
+};
+
+class IfcResetScopestats : public IfaceDecompCommand {
+public:
+  virtual void execute(istream &s);
+};
+
 class IfcVolatile : public IfaceDecompCommand {
 public:
   virtual void execute(istream &s);
@@ -252,9 +252,8 @@ void InjectPayloadDynamic::restoreEntry(const Element *el)
   iter = list.begin();
   Address addr = Address::restoreXml(*iter,glb);
   ++iter;
-  istringstream s((*iter)->getContent());
   try {
-    Document *doc = xml_tree(s);
+    Document *doc = xml_tree((*iter)->getContent());
     map<Address,Document *>::iterator iter = addrMap.find(addr);
     if (iter != addrMap.end())
       delete (*iter).second;		// Delete any preexisting document
@@ -78,6 +78,16 @@ MemoryBank::MemoryBank(AddrSpace *spc,int4 ws,int4 ps)
   pagesize = ps;
 }
 
+/// The new bank has the same contents as \b this, but the two can be modified independently.
+/// Any \e underlying bank is shared, not copied.  The caller takes responsibility for the new bank.
+/// The default implementation throws an exception; derived classes that can be copied override it.
+/// \return the new bank
+MemoryBank *MemoryBank::fork(void) const
+
+{
+  throw LowlevelError("Memory bank for space " + space->getName() + " cannot be forked");
+}
+
 /// This routine only retrieves data from a single \e page in the memory bank. Bytes need not
 /// be retrieved from the exact start of a page, but all bytes must come from \e one page.
 /// A page is a fixed number of bytes, and the address of a page is always aligned based
@@ -408,6 +418,13 @@ MemoryImage::MemoryImage(AddrSpace *spc,int4 ws,int4 ps,LoadImage *ld)
   loader = ld;
 }
 
+/// The bank is read-only, so the copy just reads from the same LoadImage
+MemoryBank *MemoryImage::fork(void) const
+
+{
+  return new MemoryImage(getSpace(),getWordSize(),getPageSize(),loader);
+}
+
 /// This derived method looks for a previously cached page of the underlying memory bank.
 /// If the cached page does not exist, it creates it and fills in its initial value by
 /// retrieving the page from the underlying bank.  The new value is then written into
@@ -543,6 +560,217 @@ MemoryPageOverlay::~MemoryPageOverlay(void)
     delete [] (*iter).second;
 }
 
+/// \param addr is an offset within the memory bank
+/// \return the table of page pointers covering the offset, or null if no page near it has been written
+uint1 **MemoryPageTable::findTable(uintb addr) const
+
+{
+  uintb key = addr >> (pageshift + tablebits);
+  if (lasttable != (uint1 **)0 && key == lastkey)
+    return lasttable;
+  map<uintb,uint1 **>::const_iterator iter = directory.find(key);
+  if (iter == directory.end())
+    return (uint1 **)0;
+  lastkey = key;
+  lasttable = (*iter).second;
+  return lasttable;
+}
+
+/// \param addr is an offset within the memory bank
+/// \return the written page containing the offset, or null if the page has not been written
+inline uint1 *MemoryPageTable::findPage(uintb addr) const
+
+{
+  uint1 **table = findTable(addr);
+  if (table == (uint1 **)0)
+    return (uint1 *)0;
+  return table[(addr >> pageshift) & ((1<<tablebits)-1)];
+}
+
+/// A table of page pointers is created if necessary.  The new page's initial value is
+/// optionally filled in from the \e underlying bank (or with zeros).
+/// \param addr is an offset within the page to create
+/// \param fill is \b true if the initial value of the page needs to be filled in
+/// \return the new page
+uint1 *MemoryPageTable::createPage(uintb addr,bool fill)
+
+{
+  uint1 **table = findTable(addr);
+  if (table == (uint1 **)0) {
+    table = new uint1 *[1<<tablebits];
+    for(int4 i=0;i<(1<<tablebits);++i)
+      table[i] = (uint1 *)0;
+    lastkey = addr >> (pageshift + tablebits);
+    lasttable = table;
+    directory[lastkey] = table;
+  }
+  uint1 *pageptr = allocatePage(getPageSize());
+  table[(addr >> pageshift) & ((1<<tablebits)-1)] = pageptr;
+  if (fill) {
+    uintb pageaddr = addr & ~((uintb)(getPageSize()-1));
+    if (underlie == (MemoryBank *)0)
+      memset(pageptr,0,getPageSize());
+    else
+      underlie->getPage(pageaddr,pageptr,0,getPageSize());
+  }
+  return pageptr;
+}
+
+/// If the page does not exist, it is created. If the page is shared with a fork, a private
+/// copy is made.
+/// \param addr is an offset within the page
+/// \param fill is \b true if the initial value of a newly created page needs to be filled in
+/// \return the page, which is not shared with any other bank
+uint1 *MemoryPageTable::writablePage(uintb addr,bool fill)
+
+{
+  uint1 **table = findTable(addr);
+  if (table == (uint1 **)0)
+    return createPage(addr,fill);
+  uint1 **slot = table + ((addr >> pageshift) & ((1<<tablebits)-1));
+  if (*slot == (uint1 *)0)
+    return createPage(addr,fill);
+  if (pageRefs(*slot) > 1) {	// Page is shared, copy on write
+    uint1 *pageptr = allocatePage(getPageSize());
+    memcpy(pageptr,*slot,getPageSize());
+    releasePage(*slot);
+    *slot = pageptr;
+  }
+  return *slot;
+}
+
+/// Each page is preceded by its reference count, padded to keep the page data aligned.
+/// \param size is the number of bytes in the page
+/// \return a pointer to the page data
+uint1 *MemoryPageTable::allocatePage(int4 size)
+
+{
+  uint1 *pageptr = new uint1[size + sizeof(uintb)] + sizeof(uintb);
+  pageRefs(pageptr) = 1;
+  return pageptr;
+}
+
+/// \param pageptr is the page data, as returned by allocatePage()
+void MemoryPageTable::releasePage(uint1 *pageptr)
+
+{
+  int4 &refs( pageRefs(pageptr) );
+  refs -= 1;
+  if (refs == 0)
+    delete [] (pageptr - sizeof(uintb));
+}
+
+/// The page containing the word is created, and filled from the \e underlying bank,
+/// if it does not already exist.  The new value is then written into the page.
+/// \param addr is the aligned address of the word to be written
+/// \param val is the value to be written at that word
+void MemoryPageTable::insert(uintb addr,uintb val)
+
+{
+  uint1 *pageptr = writablePage(addr,true);
+  uintb pageoffset = addr & ((uintb)(getPageSize()-1));
+  deconstructValue(pageptr + pageoffset,val,getWordSize(),getSpace()->isBigEndian());
+}
+
+/// If the page containing the word has been written, the word is read from it. Otherwise
+/// the request is forwarded to the \e underlying memory bank. If there is no underlying bank,
+/// zero is returned.
+/// \param addr is the aligned offset of the word
+/// \return the retrieved value
+uintb MemoryPageTable::find(uintb addr) const
+
+{
+  const uint1 *pageptr = findPage(addr);
+  if (pageptr == (const uint1 *)0) {
+    if (underlie == (MemoryBank *)0)
+      return (uintb)0;
+    return underlie->find(addr);
+  }
+  uintb pageoffset = addr & ((uintb)(getPageSize()-1));
+  return constructValue(pageptr+pageoffset,getWordSize(),getSpace()->isBigEndian());
+}
+
+/// \param addr is the aligned offset of the page
+/// \param res is the pointer to where retrieved bytes should be stored
+/// \param skip is the offset \e into \e the \e page from where bytes should be retrieved
+/// \param size is the number of bytes to retrieve
+void MemoryPageTable::getPage(uintb addr,uint1 *res,int4 skip,int4 size) const
+
+{
+  const uint1 *pageptr = findPage(addr);
+  if (pageptr == (const uint1 *)0) {
+    if (underlie == (MemoryBank *)0)
+      memset(res,0,size);
+    else
+      underlie->getPage(addr,res,skip,size);
+    return;
+  }
+  memcpy(res,pageptr+skip,size);
+}
+
+/// If the page does not exist, it is created, and its initial value is filled in from the
+/// \e underlying bank, unless the whole page is being written.
+/// \param addr is the aligned offset of the page to write
+/// \param val is a pointer to bytes to be written into the page
+/// \param skip is the offset \e into \e the \e page where bytes should be written
+/// \param size is the number of bytes to write
+void MemoryPageTable::setPage(uintb addr,const uint1 *val,int4 skip,int4 size)
+
+{
+  uint1 *pageptr = writablePage(addr,(size != getPageSize()));
+  memcpy(pageptr+skip,val,size);
+}
+
+/// \param spc is the address space associated with the memory bank
+/// \param ws is the number of bytes in the preferred wordsize (must be power of 2)
+/// \param ps is the number of bytes in a page (must be power of 2)
+/// \param ul is the underlying MemoryBank (may be null)
+MemoryPageTable::MemoryPageTable(AddrSpace *spc,int4 ws,int4 ps,MemoryBank *ul)
+  : MemoryBank(spc,ws,ps)
+{
+  underlie = ul;
+  lastkey = 0;
+  lasttable = (uint1 **)0;
+  pageshift = 0;
+  while((1<<pageshift) < ps)
+    pageshift += 1;
+}
+
+MemoryPageTable::~MemoryPageTable(void)
+
+{
+  map<uintb,uint1 **>::iterator iter;
+
+  for(iter=directory.begin();iter!=directory.end();++iter) {
+    uint1 **table = (*iter).second;
+    for(int4 i=0;i<(1<<tablebits);++i)
+      if (table[i] != (uint1 *)0)
+	releasePage(table[i]);
+    delete [] table;
+  }
+}
+
+/// Only the tables of page pointers are copied. Pages are shared by both banks until
+/// one of them writes to the page.
+/// \return the new bank
+MemoryBank *MemoryPageTable::fork(void) const
+
+{
+  MemoryPageTable *res = new MemoryPageTable(getSpace(),getWordSize(),getPageSize(),underlie);
+  map<uintb,uint1 **>::const_iterator iter;
+  for(iter=directory.begin();iter!=directory.end();++iter) {
+    uint1 **table = (*iter).second;
+    uint1 **copy = new uint1 *[1<<tablebits];
+    for(int4 i=0;i<(1<<tablebits);++i) {
+      copy[i] = table[i];
+      if (copy[i] != (uint1 *)0)
+	pageRefs(copy[i]) += 1;
+    }
+    res->directory[(*iter).first] = copy;
+  }
+  return res;
+}
+
 /// Write the value into the hashtable, using \b addr as a key.
 /// \param addr is the aligned address of the word being written
 /// \param val is the value of the word to write
@@ -611,6 +839,48 @@ MemoryHashOverlay::MemoryHashOverlay(AddrSpace *spc,int4 ws,int4 ps,int4 hashsiz
   }
 }
 
+/// The hashtable is copied in full.
+/// \return the new bank
+MemoryBank *MemoryHashOverlay::fork(void) const
+
+{
+  MemoryHashOverlay *res = new MemoryHashOverlay(getSpace(),getWordSize(),getPageSize(),address.size(),underlie);
+  res->address = address;
+  res->value = value;
+  return res;
+}
+
+/// Banks created by fork() are freed. Banks registered with setMemoryBank() are not.
+MemoryState::~MemoryState(void)
+
+{
+  for(int4 i=0;i<ownedbanks.size();++i)
+    delete ownedbanks[i];
+}
+
+/// Every registered MemoryBank is forked, and the new state takes responsibility for the
+/// new banks.  The new state starts with the same contents as \b this, but the two can be
+/// modified independently.  Banks \e underlying the registered banks are shared.
+/// An exception is thrown if any registered bank cannot be forked.
+/// \return the new MemoryState, which the caller is responsible for freeing
+MemoryState *MemoryState::fork(void) const
+
+{
+  MemoryState *res = new MemoryState(trans);
+  try {
+    for(int4 i=0;i<memspace.size();++i) {
+      if (memspace[i] == (MemoryBank *)0) continue;
+      MemoryBank *bank = memspace[i]->fork();
+      res->ownedbanks.push_back(bank);
+      res->setMemoryBank(bank);
+    }
+  } catch(LowlevelError &err) {
+    delete res;
+    throw;
+  }
+  return res;
+}
+
 /// MemoryBanks associated with specific address spaces must be registers with this MemoryState
 /// via this method.  Each address space that will be used during emulation must be registered
 /// separately.  The MemoryState object does \e not assume responsibility for freeing the MemoryBank
@@ -35,6 +35,7 @@
 
 class MemoryBank {
   friend class MemoryPageOverlay;
+  friend class MemoryPageTable;
   friend class MemoryHashOverlay;
   int4 wordsize;		///< Number of bytes in an aligned word access
   int4 pagesize;		///< Number of bytes in an aligned page access
@@ -47,6 +48,7 @@ protected:
 public:
   MemoryBank(AddrSpace *spc,int4 ws,int4 ps); ///< Generic constructor for a memory bank
   virtual ~MemoryBank(void) {}
+  virtual MemoryBank *fork(void) const;	///< Create an independent copy of \b this bank
   int4 getWordSize(void) const;	///< Get the number of bytes in a word for this memory bank
   int4 getPageSize(void) const;	///< Get the number of bytes in a page for this memory bank
   AddrSpace *getSpace(void) const; ///< Get the address space associated with this memory bank
@@ -99,6 +101,7 @@ protected:
   virtual void getPage(uintb addr,uint1 *res,int4 skip,int4 size) const; ///< Overridded getPage method
 public:
   MemoryImage(AddrSpace *spc,int4 ws,int4 ps,LoadImage *ld); ///< Constructor for a loadimage memorybank
+  virtual MemoryBank *fork(void) const;
 };
 
 /// \brief Memory bank that overlays some other memory bank, using a "copy on write" behavior.
@@ -120,6 +123,45 @@ public:
   virtual ~MemoryPageOverlay(void);
 };
 
+/// \brief Memory bank that overlays some other memory bank, using a page table to find pages.
+///
+/// This has the same "copy on write" behavior as MemoryPageOverlay, but written pages are
+/// found through a two-level page table instead of a map. The page number is split into a
+/// \e directory key and an index into a fixed size table of page pointers. The table used by
+/// the most recent access is remembered, so nearby accesses resolve with a single array lookup.
+/// The underlying memory bank can be a \b null pointer, in which case this memory bank behaves
+/// as if it were initially filled with zeros.
+///
+/// Pages are reference counted so that fork() can create a \e snapshot of the bank by copying only
+/// the tables of page pointers. A page shared between forks is cloned on its first write by either
+/// one. The reference counts are not thread-safe, so forks must be used from a single thread.
+class MemoryPageTable : public MemoryBank {
+  enum {
+    tablebits = 10		///< Number of page number bits indexing a single table
+  };
+  MemoryBank *underlie;		///< Underlying memory object
+  int4 pageshift;		///< Number of bits in a page offset
+  map<uintb,uint1 **> directory;	///< Tables of page pointers, indexed by the high bits of the page number
+  mutable uintb lastkey;	///< Directory key of the most recently used table
+  mutable uint1 **lasttable;	///< Most recently used table (or null)
+  uint1 **findTable(uintb addr) const;	///< Find the table of page pointers covering an address
+  uint1 *findPage(uintb addr) const;	///< Find the written page containing an address
+  uint1 *createPage(uintb addr,bool fill);	///< Create the page containing an address
+  uint1 *writablePage(uintb addr,bool fill);	///< Get the page containing an address, ready for writing
+  static uint1 *allocatePage(int4 size);	///< Allocate a new page with one reference
+  static void releasePage(uint1 *pageptr);	///< Remove one reference to a page, freeing it if unused
+  static int4 &pageRefs(uint1 *pageptr) { return *(int4 *)(pageptr - sizeof(uintb)); }	///< Reference count of a page
+protected:
+  virtual void insert(uintb addr,uintb val); ///< Overridden aligned word insert
+  virtual uintb find(uintb addr) const;	///< Overridden aligned word find
+  virtual void getPage(uintb addr,uint1 *res,int4 skip,int4 size) const; ///< Overridden getPage
+  virtual void setPage(uintb addr,const uint1 *val,int4 skip,int4 size); ///< Overridden setPage
+public:
+  MemoryPageTable(AddrSpace *spc,int4 ws,int4 ps,MemoryBank *ul); ///< Constructor for page table overlay
+  virtual ~MemoryPageTable(void);
+  virtual MemoryBank *fork(void) const;
+};
+
 /// \brief A memory bank that implements reads and writes using a hash table.
 ///
 /// The initial state of the
@@ -136,6 +178,7 @@ protected:
   virtual uintb find(uintb addr) const;	///< Overridden aligned word find
 public:
   MemoryHashOverlay(AddrSpace *spc,int4 ws,int4 ps,int4 hashsize,MemoryBank *ul); ///< Constructor for hash overlay
+  virtual MemoryBank *fork(void) const;
 };
 
 class Translate;		// Forward declaration
@@ -145,13 +188,19 @@ class Translate;		// Forward declaration
 /// Every piece of information in a pcode machine is representable as a triple
 /// (AddrSpace,offset,size).  This class allows getting and setting
 /// of all state information of this form.
+///
+/// A MemoryState can be forked, producing a new state that starts with the same contents
+/// but evolves independently. The cost depends on the registered banks: a MemoryPageTable is
+/// forked by sharing its pages until they are written.
 class MemoryState {
 protected:
   Translate *trans;		///< Architecture information about memory spaces
   vector<MemoryBank *> memspace; ///< Memory banks associated with each address space
+  vector<MemoryBank *> ownedbanks;	///< Banks created by fork() that \b this is responsible for
 public:
   MemoryState(Translate *t);	///< A constructor for MemoryState
-  ~MemoryState(void) {}
+  ~MemoryState(void);		///< Destructor
+  MemoryState *fork(void) const;	///< Create an independent copy of \b this state
   Translate *getTranslate(void) const; ///< Get the Translate object
   void setMemoryBank(MemoryBank *bank);	///< Map a memory bank into the state
   MemoryBank *getMemoryBank(AddrSpace *spc) const; ///< Get a memory bank associated with a particular space
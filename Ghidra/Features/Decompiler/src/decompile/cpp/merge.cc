@@ -16,6 +16,317 @@
 #include "merge.hh"
 #include "funcdata.hh"
 
+HighEdgeCache::HighEdgeCache(void)
+
+{
+  edgecount = 0;
+  stampcounter = 0;
+  numLookups = 0;
+  numHits = 0;
+  numInserts = 0;
+  numPurges = 0;
+  numPurgedTests = 0;
+}
+
+/// \param a is the first HighVariable (the smaller pointer)
+/// \param b is the second HighVariable
+/// \return the hash value
+uint4 HighEdgeCache::hashPair(HighVariable *a,HighVariable *b)
+
+{
+  uint8 val = (uint8)(uintp)a * 0x9e3779b97f4a7c15ULL + (uint8)(uintp)b;
+  val ^= val >> 29;
+  val *= 0xbf58476d1ce4e5b9ULL;
+  return (uint4)(val >> 32);
+}
+
+/// \param a is the HighVariable
+/// \return the hash value
+uint4 HighEdgeCache::hashHigh(HighVariable *a)
+
+{
+  uint8 val = (uint8)(uintp)a * 0x9e3779b97f4a7c15ULL;
+  return (uint4)(val >> 32);
+}
+
+/// \param high is the HighVariable to search for
+/// \return the index of its record or -1 if it has no record
+int4 HighEdgeCache::findRecord(HighVariable *high) const
+
+{
+  if (hightable.empty()) return -1;
+  uint4 mask = hightable.size() - 1;
+  uint4 slot = hashHigh(high) & mask;
+  for(;;) {
+    int4 index = hightable[slot];
+    if (index == -1) return -1;
+    if (records[index].high == high) return index;
+    slot = (slot + 1) & mask;
+  }
+}
+
+/// If the HighVariable has no record yet, one is created and given a fresh stamp.
+/// \param high is the HighVariable
+/// \return the index of its record
+int4 HighEdgeCache::getRecord(HighVariable *high)
+
+{
+  if ((records.size()+1)*2 > hightable.size())
+    rehashHighs(hightable.empty() ? 64 : hightable.size() * 2);
+  uint4 mask = hightable.size() - 1;
+  uint4 slot = hashHigh(high) & mask;
+  for(;;) {
+    int4 index = hightable[slot];
+    if (index == -1) break;
+    if (records[index].high == high) return index;
+    slot = (slot + 1) & mask;
+  }
+  int4 index = records.size();
+  records.push_back(HighRecord());
+  records.back().high = high;
+  records.back().stamp = ++stampcounter;
+  hightable[slot] = index;
+  return index;
+}
+
+/// \param high is the HighVariable
+/// \return its current stamp or 0 if it has never been tested
+uint4 HighEdgeCache::getStamp(HighVariable *high) const
+
+{
+  int4 index = findRecord(high);
+  if (index == -1) return 0;
+  return records[index].stamp;
+}
+
+/// The table must not be empty.
+/// \param a is the first HighVariable (the smaller pointer)
+/// \param b is the second HighVariable
+/// \return the index of the slot holding the pair, or the empty slot where it would be inserted
+int4 HighEdgeCache::findEdgeSlot(HighVariable *a,HighVariable *b) const
+
+{
+  uint4 mask = edgetable.size() - 1;
+  uint4 slot = hashPair(a,b) & mask;
+  for(;;) {
+    const Edge &edge( edgetable[slot] );
+    if (edge.a == (HighVariable *)0) return slot;
+    if ((edge.a == a)&&(edge.b == b)) return slot;
+    slot = (slot + 1) & mask;
+  }
+}
+
+/// \param edge is the cached test
+/// \return \b true if neither HighVariable has been purged since the test was made
+bool HighEdgeCache::isValid(const Edge &edge) const
+
+{
+  if (edge.stampa == 0) return false;
+  if (edge.stampa != getStamp(edge.a)) return false;
+  return (edge.stampb == getStamp(edge.b));
+}
+
+/// Only tests that are still valid are copied into the new table, and the list of partners
+/// for each HighVariable is rebuilt from them.
+/// \param newsize is the number of slots in the new table (a power of 2)
+void HighEdgeCache::rehashEdges(int4 newsize)
+
+{
+  vector<Edge> oldtable;
+  oldtable.swap(edgetable);
+  Edge emptyedge;
+  emptyedge.a = (HighVariable *)0;
+  emptyedge.b = (HighVariable *)0;
+  emptyedge.stampa = 0;
+  emptyedge.stampb = 0;
+  emptyedge.result = false;
+  edgetable.resize(newsize,emptyedge);
+  edgecount = 0;
+  for(int4 i=0;i<records.size();++i)
+    records[i].partners.clear();
+  for(int4 i=0;i<oldtable.size();++i) {
+    const Edge &edge( oldtable[i] );
+    if (edge.a == (HighVariable *)0) continue;
+    if (!isValid(edge)) continue;
+    edgetable[findEdgeSlot(edge.a,edge.b)] = edge;
+    edgecount += 1;
+    records[findRecord(edge.a)].partners.push_back(edge.b);
+    records[findRecord(edge.b)].partners.push_back(edge.a);
+  }
+}
+
+/// \param newsize is the number of slots in the new table (a power of 2)
+void HighEdgeCache::rehashHighs(int4 newsize)
+
+{
+  hightable.assign(newsize,-1);
+  uint4 mask = newsize - 1;
+  for(int4 i=0;i<records.size();++i) {
+    uint4 slot = hashHigh(records[i].high) & mask;
+    while(hightable[slot] != -1)
+      slot = (slot + 1) & mask;
+    hightable[slot] = i;
+  }
+}
+
+void HighEdgeCache::clear(void)
+
+{
+  edgetable.clear();
+  edgecount = 0;
+  hightable.clear();
+  records.clear();
+  numLookups = 0;
+  numHits = 0;
+  numInserts = 0;
+  numPurges = 0;
+  numPurgedTests = 0;
+}
+
+/// \param a is the first HighVariable
+/// \param b is the second HighVariable
+/// \param res will hold the intersection result if it is cached
+/// \return \b true if a valid test was found
+bool HighEdgeCache::find(HighVariable *a,HighVariable *b,bool &res)
+
+{
+  numLookups += 1;
+  if (edgetable.empty()) return false;
+  if (b < a) {
+    HighVariable *tmp = a;
+    a = b;
+    b = tmp;
+  }
+  const Edge &edge( edgetable[findEdgeSlot(a,b)] );
+  if (edge.a == (HighVariable *)0) return false;
+  if (!isValid(edge)) return false;
+  numHits += 1;
+  res = edge.result;
+  return true;
+}
+
+/// \param a is the first HighVariable
+/// \param b is the second HighVariable
+/// \param res is \b true if the two variables intersect
+void HighEdgeCache::insert(HighVariable *a,HighVariable *b,bool res)
+
+{
+  if (b < a) {
+    HighVariable *tmp = a;
+    a = b;
+    b = tmp;
+  }
+  if ((edgecount+1)*2 > edgetable.size()) {
+    int4 live = 0;
+    for(int4 i=0;i<edgetable.size();++i) {
+      if (edgetable[i].a != (HighVariable *)0 && isValid(edgetable[i]))
+	live += 1;
+    }
+    int4 newsize = edgetable.empty() ? 64 : edgetable.size();
+    while((live+1)*4 > newsize)		// Leave room to grow after dropping stale tests
+      newsize *= 2;
+    rehashEdges(newsize);
+  }
+  int4 indexa = getRecord(a);
+  int4 indexb = getRecord(b);
+  Edge &edge( edgetable[findEdgeSlot(a,b)] );
+  bool wasvalid = false;
+  if (edge.a == (HighVariable *)0) {
+    edge.a = a;
+    edge.b = b;
+    edgecount += 1;
+  }
+  else
+    wasvalid = isValid(edge);
+  edge.stampa = records[indexa].stamp;
+  edge.stampb = records[indexb].stamp;
+  edge.result = res;
+  if (!wasvalid) {
+    records[indexa].partners.push_back(b);
+    records[indexb].partners.push_back(a);
+  }
+  numInserts += 1;
+}
+
+/// \param a is the first HighVariable
+/// \param b is the second HighVariable
+void HighEdgeCache::invalidate(HighVariable *a,HighVariable *b)
+
+{
+  if (edgetable.empty()) return;
+  if (b < a) {
+    HighVariable *tmp = a;
+    a = b;
+    b = tmp;
+  }
+  Edge &edge( edgetable[findEdgeSlot(a,b)] );
+  if (edge.a != (HighVariable *)0)
+    edge.stampa = 0;
+}
+
+/// The HighVariable is issued a new stamp, which invalidates every test recorded
+/// with its previous stamp.
+/// \param high is the given HighVariable
+void HighEdgeCache::purge(HighVariable *high)
+
+{
+  numPurges += 1;
+  int4 index = findRecord(high);
+  if (index == -1) return;		// No tests have been cached for this variable
+  HighRecord &rec( records[index] );
+  rec.stamp = ++stampcounter;
+  numPurgedTests += rec.partners.size();
+  rec.partners.clear();
+}
+
+/// \brief Collect the variables with a valid cached test against the given HighVariable
+///
+/// \param high is the given HighVariable
+/// \param yes will hold the variables that intersect \b high
+/// \param no will hold the variables that do not intersect \b high
+void HighEdgeCache::collectTests(HighVariable *high,vector<HighVariable *> &yes,vector<HighVariable *> &no)
+
+{
+  int4 index = findRecord(high);
+  if (index == -1) return;
+  const vector<HighVariable *> &partners( records[index].partners );
+  for(int4 i=0;i<partners.size();++i) {
+    HighVariable *a = high;
+    HighVariable *b = partners[i];
+    if (b < a) {
+      a = b;
+      b = high;
+    }
+    const Edge &edge( edgetable[findEdgeSlot(a,b)] );
+    if (edge.a == (HighVariable *)0) continue;
+    if (!isValid(edge)) continue;
+    if (edge.result)
+      yes.push_back(partners[i]);
+    else
+      no.push_back(partners[i]);
+  }
+  // A partner may be listed more than once if its test was redone
+  sort(yes.begin(),yes.end());
+  yes.erase(unique(yes.begin(),yes.end()),yes.end());
+  sort(no.begin(),no.end());
+  no.erase(unique(no.begin(),no.end()),no.end());
+}
+
+/// \param s is the output stream
+void HighEdgeCache::printStatistics(ostream &s) const
+
+{
+  s << "Intersection tests looked up: " << dec << numLookups << endl;
+  s << "Cache hits: " << numHits;
+  if (numLookups != 0)
+    s << " (" << fixed << setprecision(1) << (100.0 * (double)numHits / (double)numLookups) << "%)";
+  s << endl;
+  s << "Tests cached: " << numInserts << endl;
+  s << "Table slots in use: " << edgecount << " of " << edgetable.size() << endl;
+  s << "Variables tracked: " << records.size() << endl;
+  s << "Purges: " << numPurges << " (" << numPurgedTests << " tests invalidated)" << endl;
+}
+
 /// This instance assumes the identity of the given Varnode and the defining index is
 /// cached to facilitate quick sorting.
 /// \param v is the given Varnode
@@ -419,7 +730,7 @@ void Merge::eliminateIntersect(Varnode *vn,const vector<BlockVarnode> &blocksort
 {
   list<PcodeOp *> markedop;
   list<PcodeOp *>::const_iterator oiter;
-  map<int4,CoverBlock>::const_iterator iter,enditer;
+  Cover::BlockList::const_iterator iter,enditer;
   Varnode *vn2;
   int4 boundtype;
   bool insertop;
@@ -1383,49 +1694,22 @@ bool Merge::merge(HighVariable *high1,HighVariable *high2,bool isspeculative)
 				// Translate any tests for high2 into tests for high1
   vector<HighVariable *> yesinter;		// Highs that high2 intersects
   vector<HighVariable *> nointer;		// Highs that high2 does not intersect
-  map<HighEdge,bool>::iterator iterfirst = highedgemap.lower_bound( HighEdge(high2,(HighVariable *)0) );
-  map<HighEdge,bool>::iterator iterlast = highedgemap.lower_bound( HighEdge(high2,(HighVariable *)~((uintp)0)) );
-  map<HighEdge,bool>::iterator iter;
-
-  for(iter=iterfirst;iter!=iterlast;++iter) {
-    HighVariable *b = (*iter).first.b; 
-    if (b == high1) continue;
-    if ((*iter).second)		// Save all high2's intersections
-      yesinter.push_back(b);	// as they are still valid for the merge
-    else {
-      nointer.push_back(b);
-      b->setMark();		// Mark that high2 did not intersect
-    }
-  }
-				// Do a purge of all high2's tests
-  if (iterfirst != iterlast) {	// Delete all the high2 tests
-    --iterlast;			// Move back 1 to prevent deleting under the iterator
-    for(iter=iterfirst;iter!=iterlast;++iter)
-      highedgemap.erase( HighEdge( (*iter).first.b, (*iter).first.a) );
-    highedgemap.erase( HighEdge( (*iter).first.b, (*iter).first.a) );
-    ++iterlast;			// Restore original range (with possibly new open endpoint)
-  
-    highedgemap.erase(iterfirst,iterlast);
-  }
+  testCache.collectTests(high2,yesinter,nointer);
+  testCache.purge(high2);			// Delete all the high2 tests
 
-  iter = highedgemap.lower_bound( HighEdge(high1,(HighVariable *)0) );
-  while((iter!=highedgemap.end())&&((*iter).first.a == high1)) {
-    if (!(*iter).second) {	// If test is intersection==false
-      if (!(*iter).first.b->isMark()) // and there was no test with high2
-	highedgemap.erase( iter++ ); // Delete the test
-      else
-	++iter;
-    }
-    else			// Keep any intersection==true tests
-      ++iter;
-  }
+  vector<HighVariable *> yesinter1;
+  vector<HighVariable *> nointer1;
+  testCache.collectTests(high1,yesinter1,nointer1);
   vector<HighVariable *>::iterator titer;
-  for(titer=nointer.begin();titer!=nointer.end();++titer)
-    (*titer)->clearMark();
+  for(titer=nointer1.begin();titer!=nointer1.end();++titer) {
+    // Tests where high1 did not intersect only remain valid if high2 did not intersect either
+    if (!binary_search(nointer.begin(),nointer.end(),*titer))
+      testCache.invalidate(high1,*titer);
+  }
 				// Reinsert high2's intersection==true tests for high1 now
   for(titer=yesinter.begin();titer!=yesinter.end();++titer) {
-    highedgemap[ HighEdge(high1,*titer) ] = true;
-    highedgemap[ HighEdge(*titer,high1) ] = true;
+    if (*titer == high1) continue;
+    testCache.insert(high1,*titer,true);
   }
   high1->merge(high2,isspeculative);		// Do the actual merge
   high1->updateCover();
@@ -1456,18 +1740,7 @@ bool Merge::updateHigh(HighVariable *a)
 void Merge::purgeHigh(HighVariable *high)
 
 {
-  map<HighEdge,bool>::iterator iterfirst = highedgemap.lower_bound( HighEdge(high,(HighVariable *)0) );
-  map<HighEdge,bool>::iterator iterlast = highedgemap.lower_bound( HighEdge(high,(HighVariable *)~((uintp)0)) );
-
-  if (iterfirst == iterlast) return;
-  --iterlast;			// Move back 1 to prevent deleting under the iterator
-  map<HighEdge,bool>::iterator iter;
-  for(iter=iterfirst;iter!=iterlast;++iter)
-    highedgemap.erase( HighEdge( (*iter).first.b, (*iter).first.a) );
-  highedgemap.erase( HighEdge( (*iter).first.b, (*iter).first.a) );
-  ++iterlast;			// Restore original range (with possibly new open endpoint)
-  
-  highedgemap.erase(iterfirst,iterlast);
+  testCache.purge(high);
 }
 
 /// \brief Test the intersection of two HighVariables and cache the result
@@ -1485,9 +1758,9 @@ bool Merge::intersection(HighVariable *a,HighVariable *b)
   bool ares = updateHigh(a);
   bool bres = updateHigh(b);
   if (ares && bres) {		// If neither high was dirty
-    map<HighEdge,bool>::iterator iter = highedgemap.find( HighEdge(a,b) );
-    if (iter != highedgemap.end()) // If previous test is present
-      return (*iter).second;	// Use it
+    bool cached;
+    if (testCache.find(a,b,cached)) // If previous test is present
+      return cached;		// Use it
   }
 
   bool res = false;
@@ -1500,8 +1773,7 @@ bool Merge::intersection(HighVariable *a,HighVariable *b)
       break;
     }
   }
-  highedgemap[ HighEdge(a,b) ] = res; // Cache the result
-  highedgemap[ HighEdge(b,a) ] = res;
+  testCache.insert(a,b,res);	// Cache the result
   return res;
 }
 
@@ -21,19 +21,57 @@
 
 #include "op.hh"
 
-/// \brief A record for caching a Cover intersection test between two HighVariable objects
+/// \brief A cache of Cover intersection tests between pairs of HighVariable objects
 ///
-/// This is just a pair of HighVariable objects that can be used as a map key. The main
-/// Merge class uses it to cache intersection test results between the two variables in
-/// a map.
-class HighEdge {
-  friend class Merge;
-  HighVariable *a;		///< First HighVariable of the pair
-  HighVariable *b;		///< Second HighVariable of the pair
+/// Test results are stored in an open-addressing hash table keyed on the (unordered) pair
+/// of HighVariables.  Each HighVariable has a record holding an invalidation \e stamp and
+/// a list of the variables it has been tested against.  A cached test is only valid if the stamps
+/// recorded with it match the current stamps of both variables, so all tests involving a single
+/// HighVariable can be \e purged in constant time by issuing it a new stamp.
+/// Stale slots are dropped when the table is rebuilt.
+class HighEdgeCache {
+  /// \brief A single cached intersection test
+  struct Edge {
+    HighVariable *a;		///< First HighVariable of the pair (the smaller pointer)
+    HighVariable *b;		///< Second HighVariable of the pair
+    uint4 stampa;		///< Stamp of the first HighVariable when the test was made (0 = invalid)
+    uint4 stampb;		///< Stamp of the second HighVariable when the test was made
+    bool result;		///< \b true if the two HighVariables intersect
+  };
+  /// \brief Invalidation stamp and test partners for a single HighVariable
+  struct HighRecord {
+    HighVariable *high;			///< The HighVariable
+    uint4 stamp;			///< Current stamp of the HighVariable
+    vector<HighVariable *> partners;	///< Variables tested against since the last purge (may hold stale entries)
+  };
+  vector<Edge> edgetable;	///< Hash table of tests (\b a == null marks an empty slot)
+  int4 edgecount;		///< Number of occupied slots in the test table
+  vector<int4> hightable;	///< Hash table of indices into \b records (-1 marks an empty slot)
+  vector<HighRecord> records;	///< Records for each HighVariable that has been tested
+  uint4 stampcounter;		///< Last stamp handed out
+  uintb numLookups;		///< Number of cache lookups
+  uintb numHits;		///< Number of lookups that returned a valid test
+  uintb numInserts;		///< Number of test results added to the cache
+  uintb numPurges;		///< Number of HighVariable purges
+  uintb numPurgedTests;		///< Number of tests (potentially) invalidated by purges
+  static uint4 hashPair(HighVariable *a,HighVariable *b);	///< Hash a pair of HighVariables
+  static uint4 hashHigh(HighVariable *a);		///< Hash a single HighVariable
+  int4 findRecord(HighVariable *high) const;		///< Find the record index of a HighVariable
+  int4 getRecord(HighVariable *high);			///< Find or create the record for a HighVariable
+  uint4 getStamp(HighVariable *high) const;		///< Get the current stamp of a HighVariable (0 if none)
+  int4 findEdgeSlot(HighVariable *a,HighVariable *b) const;	///< Find the slot holding, or able to hold, the given pair
+  bool isValid(const Edge &edge) const;		///< Do the stamps of the given test match its variables
+  void rehashEdges(int4 newsize);		///< Rebuild the test table, dropping stale entries
+  void rehashHighs(int4 newsize);		///< Rebuild the HighVariable table
 public:
-  /// \brief Comparator
-  bool operator<(const HighEdge &op2) const { if (a==op2.a) return (b<op2.b); return (a<op2.a); }
-  HighEdge(HighVariable *c,HighVariable *d) { a=c; b=d; } ///< Constructor
+  HighEdgeCache(void);				///< Construct an empty cache
+  void clear(void);				///< Remove all tests and records and reset statistics
+  bool find(HighVariable *a,HighVariable *b,bool &res);	///< Look up a cached test between two HighVariables
+  void insert(HighVariable *a,HighVariable *b,bool res);	///< Cache the test result between two HighVariables
+  void invalidate(HighVariable *a,HighVariable *b);	///< Remove the cached test between two HighVariables
+  void purge(HighVariable *high);		///< Remove all cached tests involving the given HighVariable
+  void collectTests(HighVariable *high,vector<HighVariable *> &yes,vector<HighVariable *> &no);
+  void printStatistics(ostream &s) const;	///< Print hit rate, size, and purge counts
 };
 
 /// \brief Helper class associating a Varnode with the block where it is defined
@@ -79,7 +117,7 @@ class Funcdata;
 ///   - Merging Varnodes that hold the same data-type
 class Merge {
   Funcdata &data;		///< The function containing the Varnodes to be merged
-  map<HighEdge,bool> highedgemap; ///< A cache of intersection tests, sorted by HighVariable pair
+  HighEdgeCache testCache;	///< A cache of intersection tests between HighVariable pairs
   vector<PcodeOp *> copyTrims;	///< COPY ops inserted to facilitate merges
   bool updateHigh(HighVariable *a); ///< Make sure given HighVariable's Cover is up-to-date
   void purgeHigh(HighVariable *high); ///< Remove cached intersection tests for a given HighVariable
@@ -115,6 +153,8 @@ class Merge {
   void processHighRedundantCopy(HighVariable *high);
 public:
   Merge(Funcdata &fd) : data(fd) {} ///< Construct given a specific function
+  void clear(void) { testCache.clear(); }	///< Clear any cached state for a new decompilation
+  const HighEdgeCache &getTestCache(void) const { return testCache; }	///< Get the intersection test cache
   bool intersection(HighVariable *a,HighVariable *b);
   bool inflateTest(Varnode *a,HighVariable *high);
   void inflate(Varnode *a,HighVariable *high);
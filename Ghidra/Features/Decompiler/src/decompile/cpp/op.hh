@@ -105,7 +105,8 @@ public:
     modified = 4,		///< This op has been modified by the current action
     warning = 8,		///< Warning has been generated for this op
     incidental_copy = 0x10,	///< Treat this as \e incidental for parameter recovery algorithms
-    is_cpool_transformed = 0x20 ///< Have we checked for cpool transforms
+    is_cpool_transformed = 0x20, ///< Have we checked for cpool transforms
+    revisit = 0x40		///< Op or its neighborhood changed since an ActionPool last examined it
   };
 private:
   TypeOp *opcode;		///< Pointer to class providing behavioral details of the operation
@@ -184,6 +185,7 @@ public:
   bool isInstructionStart(void) const { return ((flags&PcodeOp::startmark)!=0); } ///< Return \b true if this starts an instruction
   bool isBlockStart(void) const { return ((flags&PcodeOp::startbasic)!=0); } ///< Return \b true if this starts a basic block
   bool isModified(void) const { return ((addlflags&PcodeOp::modified)!=0); } ///< Return \b true if this is modified by the current action
+  bool isRevisit(void) const { return ((addlflags&PcodeOp::revisit)!=0); } ///< Return \b true if this needs to be revisited by rules
   bool isMark(void) const { return ((flags&PcodeOp::mark)!=0); } ///< Return \b true if this op has been marked
   void setMark(void) const { flags |= PcodeOp::mark; } ///< Set the mark on this op
   bool isWarning(void) const { return ((addlflags&PcodeOp::warning)!=0); } ///< Return \b true if a warning has been generated for this op
@@ -248,6 +250,7 @@ class PcodeOpBank {
   list<PcodeOp *> returnlist;		///< List of RETURN PcodeOps
   list<PcodeOp *> useroplist;		///< List of user-defined PcodeOps
   list<PcodeOp *> deadandgone;		///< List of retired PcodeOps
+  SlabPool<PcodeOp> opPool;		///< Memory for the PcodeOps owned by \b this
   uintm uniqid;				///< Counter for producing unique id's for each op
   void addToCodeList(PcodeOp *op);	///< Add given PcodeOp to specific op-code list
   void removeFromCodeList(PcodeOp *op);	///< Remove given PcodeOp from specific op-code list
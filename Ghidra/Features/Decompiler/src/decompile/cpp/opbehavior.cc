@@ -138,6 +138,33 @@ uintb OpBehavior::recoverInputUnary(int4 sizeout,uintb out,int4 sizein) const
   throw LowlevelError("Cannot recover input parameter without loss of information");
 }
 
+/// The default implementation calls evaluateUnary() on each value in turn.
+/// \param sizeout is the size of the output in bytes
+/// \param sizein is the size of the input in bytes
+/// \param in1 is the array of input values
+/// \param out is the array that will hold the output values
+/// \param num is the number of values in each array
+void OpBehavior::evaluateUnaryBatch(int4 sizeout,int4 sizein,const uintb *in1,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = evaluateUnary(sizeout,sizein,in1[i]);
+}
+
+/// The default implementation calls evaluateBinary() on each pair of values in turn.
+/// \param sizeout is the size of the output in bytes
+/// \param sizein is the size of the inputs in bytes
+/// \param in1 is the array of first input values
+/// \param in2 is the array of second input values
+/// \param out is the array that will hold the output values
+/// \param num is the number of values in each array
+void OpBehavior::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = evaluateBinary(sizeout,sizein,in1[i],in2[i]);
+}
+
 /// If the output value and one of the input values is known, recover the value
 /// of the other input.
 /// \param slot is the input slot to recover
@@ -164,6 +191,13 @@ uintb OpBehaviorCopy::recoverInputUnary(int4 sizeout,uintb out,int4 sizein) cons
   return out;
 }
 
+void OpBehaviorCopy::evaluateUnaryBatch(int4 sizeout,int4 sizein,const uintb *in1,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = in1[i];
+}
+
 uintb OpBehaviorEqual::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -171,6 +205,13 @@ uintb OpBehaviorEqual::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb i
   return res;
 }
 
+void OpBehaviorEqual::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = (in1[i] == in2[i]) ? 1 : 0;
+}
+
 uintb OpBehaviorNotEqual::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -178,6 +219,13 @@ uintb OpBehaviorNotEqual::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uint
   return res;
 }
 
+void OpBehaviorNotEqual::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = (in1[i] != in2[i]) ? 1 : 0;
+}
+
 uintb OpBehaviorIntSless::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -198,6 +246,25 @@ uintb OpBehaviorIntSless::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uint
   return res;
 }
 
+void OpBehaviorIntSless::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  if (sizein <= 0) {
+    for(int4 i=0;i<num;++i)
+      out[i] = 0;
+    return;
+  }
+  uintb mask = 0x80;
+  mask <<= 8*(sizein-1);
+  for(int4 i=0;i<num;++i) {
+    uintb bit1 = in1[i] & mask;	// Get the sign bits
+    uintb bit2 = in2[i] & mask;
+    uintb lt = (in1[i] < in2[i]) ? 1 : 0;
+    uintb neg = (bit1 != 0) ? 1 : 0;
+    out[i] = (bit1 != bit2) ? neg : lt;
+  }
+}
+
 uintb OpBehaviorIntSlessEqual::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -218,6 +285,25 @@ uintb OpBehaviorIntSlessEqual::evaluateBinary(int4 sizeout,int4 sizein,uintb in1
   return res;
 }
 
+void OpBehaviorIntSlessEqual::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  if (sizein <= 0) {
+    for(int4 i=0;i<num;++i)
+      out[i] = 0;
+    return;
+  }
+  uintb mask = 0x80;
+  mask <<= 8*(sizein-1);
+  for(int4 i=0;i<num;++i) {
+    uintb bit1 = in1[i] & mask;	// Get the sign bits
+    uintb bit2 = in2[i] & mask;
+    uintb le = (in1[i] <= in2[i]) ? 1 : 0;
+    uintb neg = (bit1 != 0) ? 1 : 0;
+    out[i] = (bit1 != bit2) ? neg : le;
+  }
+}
+
 uintb OpBehaviorIntLess::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -225,6 +311,13 @@ uintb OpBehaviorIntLess::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb
   return res;
 }
 
+void OpBehaviorIntLess::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = (in1[i] < in2[i]) ? 1 : 0;
+}
+
 uintb OpBehaviorIntLessEqual::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -232,6 +325,13 @@ uintb OpBehaviorIntLessEqual::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,
   return res;
 }
 
+void OpBehaviorIntLessEqual::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = (in1[i] <= in2[i]) ? 1 : 0;
+}
+
 uintb OpBehaviorIntZext::evaluateUnary(int4 sizeout,int4 sizein,uintb in1) const
 
 {
@@ -247,6 +347,13 @@ uintb OpBehaviorIntZext::recoverInputUnary(int4 sizeout,uintb out,int4 sizein) c
   return out;
 }
 
+void OpBehaviorIntZext::evaluateUnaryBatch(int4 sizeout,int4 sizein,const uintb *in1,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = in1[i];
+}
+
 uintb OpBehaviorIntSext::evaluateUnary(int4 sizeout,int4 sizein,uintb in1) const
 
 {
@@ -271,6 +378,23 @@ uintb OpBehaviorIntSext::recoverInputUnary(int4 sizeout,uintb out,int4 sizein) c
   return (out&maskshort);
 }
 
+void OpBehaviorIntSext::evaluateUnaryBatch(int4 sizeout,int4 sizein,const uintb *in1,uintb *out,int4 num) const
+
+{
+  if (sizein <= 0 || sizein > sizeof(uintb)) {	// Sign bit must be inside a uintb for the shift below
+    OpBehavior::evaluateUnaryBatch(sizeout,sizein,in1,out,num);
+    return;
+  }
+  int4 signbit = sizein*8 - 1;
+  uintb maskin = calc_mask(sizein);
+  uintb ext = (sizein >= sizeout) ? 0 : (calc_mask(sizeout) & ~maskin);	// Bits filled by a set sign bit
+  for(int4 i=0;i<num;++i) {
+    uintb val = in1[i] & maskin;
+    uintb sign = (val >> signbit) & 1;
+    out[i] = val | (ext & (0 - sign));
+  }
+}
+
 uintb OpBehaviorIntAdd::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -285,6 +409,14 @@ uintb OpBehaviorIntAdd::recoverInputBinary(int4 slot,int4 sizeout,uintb out,int4
   return res;
 }
 
+void OpBehaviorIntAdd::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  uintb mask = calc_mask(sizeout);
+  for(int4 i=0;i<num;++i)
+    out[i] = (in1[i] + in2[i]) & mask;
+}
+
 uintb OpBehaviorIntSub::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -304,6 +436,14 @@ uintb OpBehaviorIntSub::recoverInputBinary(int4 slot,int4 sizeout,uintb out,int4
   return res;
 }
 
+void OpBehaviorIntSub::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  uintb mask = calc_mask(sizeout);
+  for(int4 i=0;i<num;++i)
+    out[i] = (in1[i] - in2[i]) & mask;
+}
+
 uintb OpBehaviorIntCarry::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -357,6 +497,14 @@ uintb OpBehaviorIntNegate::evaluateUnary(int4 sizeout,int4 sizein,uintb in1) con
   return res;
 }
 
+void OpBehaviorIntNegate::evaluateUnaryBatch(int4 sizeout,int4 sizein,const uintb *in1,uintb *out,int4 num) const
+
+{
+  uintb mask = calc_mask(sizein);
+  for(int4 i=0;i<num;++i)
+    out[i] = (~in1[i]) & mask;
+}
+
 uintb OpBehaviorIntXor::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -364,6 +512,13 @@ uintb OpBehaviorIntXor::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb
   return res;
 }
 
+void OpBehaviorIntXor::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = in1[i] ^ in2[i];
+}
+
 uintb OpBehaviorIntAnd::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -371,6 +526,13 @@ uintb OpBehaviorIntAnd::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb
   return res;
 }
 
+void OpBehaviorIntAnd::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = in1[i] & in2[i];
+}
+
 uintb OpBehaviorIntOr::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -378,6 +540,13 @@ uintb OpBehaviorIntOr::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb i
   return res;
 }
 
+void OpBehaviorIntOr::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  for(int4 i=0;i<num;++i)
+    out[i] = in1[i] | in2[i];
+}
+
 uintb OpBehaviorIntLeft::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -399,6 +568,17 @@ uintb OpBehaviorIntLeft::recoverInputBinary(int4 slot,int4 sizeout,uintb out,int
   return out >> sa;
 }
 
+void OpBehaviorIntLeft::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  uintb mask = calc_mask(sizeout);
+  uintb limit = (sizeout < sizeof(uintb)) ? sizeout*8 : 8*sizeof(uintb);	// Counts past the width of uintb shift everything out
+  for(int4 i=0;i<num;++i) {
+    uintb res = (in1[i] << (in2[i] & 63)) & mask;	// Keep the shift defined, out of range is zeroed below
+    out[i] = (in2[i] < limit) ? res : 0;
+  }
+}
+
 uintb OpBehaviorIntRight::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -421,6 +601,17 @@ uintb OpBehaviorIntRight::recoverInputBinary(int4 slot,int4 sizeout,uintb out,in
   return out << sa;
 }
 
+void OpBehaviorIntRight::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  uintb mask = calc_mask(sizeout);
+  uintb limit = (sizeout < sizeof(uintb)) ? sizeout*8 : 8*sizeof(uintb);	// Counts past the width of uintb shift everything out
+  for(int4 i=0;i<num;++i) {
+    uintb res = (in1[i] & mask) >> (in2[i] & 63);	// Keep the shift defined, out of range is zeroed below
+    out[i] = (in2[i] < limit) ? res : 0;
+  }
+}
+
 uintb OpBehaviorIntSright::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
@@ -466,6 +657,14 @@ uintb OpBehaviorIntMult::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb
   return res;
 }
 
+void OpBehaviorIntMult::evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const
+
+{
+  uintb mask = calc_mask(sizeout);
+  for(int4 i=0;i<num;++i)
+    out[i] = (in1[i] * in2[i]) & mask;
+}
+
 uintb OpBehaviorIntDiv::evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const
 
 {
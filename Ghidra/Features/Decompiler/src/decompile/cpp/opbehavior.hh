@@ -39,6 +39,10 @@ struct EvaluationError : public LowlevelError {
 ///    * uintb evaluateUnary(int4 sizeout,int4 sizein,uintb in1)
 ///    * uintb recoverInputBinary(int4 slot,int4 sizeout,uintb out,int4 sizein,uintb in)
 ///    * uintb recoverInputUnary(int4 sizeout,uintb out,int4 sizein)
+///
+/// The \e batch variants, evaluateUnaryBatch() and evaluateBinaryBatch(), apply the
+/// same operation to whole arrays of input values with a single virtual call.  The common
+/// integer operations override these with simple loops that the compiler can vectorize.
 class OpBehavior {
   OpCode opcode;		///< the internal enumeration for pcode types
   bool isunary;			///< true= use unary interfaces,  false = use binary
@@ -71,6 +75,12 @@ public:
   /// \brief Reverse the unary op-code operation, recovering the input value
   virtual uintb recoverInputUnary(int4 sizeout,uintb out,int4 sizein) const;
 
+  /// \brief Emulate the unary op-code on an array of input values
+  virtual void evaluateUnaryBatch(int4 sizeout,int4 sizein,const uintb *in1,uintb *out,int4 num) const;
+
+  /// \brief Emulate the binary op-code on arrays of input values
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
+
   static void registerInstructions(vector<OpBehavior *> &inst,const Translate *trans); ///< Build all pcode behaviors
 };
 
@@ -125,6 +135,7 @@ public:
   OpBehaviorCopy(void) : OpBehavior(CPUI_COPY,true) {}	///< Constructor
   virtual uintb evaluateUnary(int4 sizeout,int4 sizein,uintb in1) const;
   virtual uintb recoverInputUnary(int4 sizeout,uintb out,int4 sizein) const;
+  virtual void evaluateUnaryBatch(int4 sizeout,int4 sizein,const uintb *in1,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_EQUAL behavior
@@ -132,6 +143,7 @@ class OpBehaviorEqual : public OpBehavior {
 public:
   OpBehaviorEqual(void) : OpBehavior(CPUI_INT_EQUAL,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_NOTEQUAL behavior
@@ -139,6 +151,7 @@ class OpBehaviorNotEqual : public OpBehavior {
 public:
   OpBehaviorNotEqual(void) : OpBehavior(CPUI_INT_NOTEQUAL,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_SLESS behavior
@@ -146,6 +159,7 @@ class OpBehaviorIntSless : public OpBehavior {
 public:
   OpBehaviorIntSless(void) : OpBehavior(CPUI_INT_SLESS,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_SLESSEQUAL behavior
@@ -153,6 +167,7 @@ class OpBehaviorIntSlessEqual : public OpBehavior {
 public:
   OpBehaviorIntSlessEqual(void) : OpBehavior(CPUI_INT_SLESSEQUAL,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_LESS behavior
@@ -160,6 +175,7 @@ class OpBehaviorIntLess : public OpBehavior {
 public:
   OpBehaviorIntLess(void) : OpBehavior(CPUI_INT_LESS,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_LESSEQUAL behavior
@@ -167,6 +183,7 @@ class OpBehaviorIntLessEqual : public OpBehavior {
 public:
   OpBehaviorIntLessEqual(void): OpBehavior(CPUI_INT_LESSEQUAL,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_ZEXT behavior
@@ -175,6 +192,7 @@ public:
   OpBehaviorIntZext(void): OpBehavior(CPUI_INT_ZEXT,true) {}	///< Constructor
   virtual uintb evaluateUnary(int4 sizeout,int4 sizein,uintb in1) const;
   virtual uintb recoverInputUnary(int4 sizeout,uintb out,int4 sizein) const;
+  virtual void evaluateUnaryBatch(int4 sizeout,int4 sizein,const uintb *in1,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_SEXT behavior
@@ -183,6 +201,7 @@ public:
   OpBehaviorIntSext(void): OpBehavior(CPUI_INT_SEXT,true) {}	///< Constructor
   virtual uintb evaluateUnary(int4 sizeout,int4 sizein,uintb in1) const;
   virtual uintb recoverInputUnary(int4 sizeout,uintb out,int4 sizein) const;
+  virtual void evaluateUnaryBatch(int4 sizeout,int4 sizein,const uintb *in1,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_ADD behavior
@@ -191,6 +210,7 @@ public:
   OpBehaviorIntAdd(void): OpBehavior(CPUI_INT_ADD,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
   virtual uintb recoverInputBinary(int4 slot,int4 sizeout,uintb out,int4 sizein,uintb in) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_SUB behavior
@@ -199,6 +219,7 @@ public:
   OpBehaviorIntSub(void): OpBehavior(CPUI_INT_SUB,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
   virtual uintb recoverInputBinary(int4 slot,int4 sizeout,uintb out,int4 sizein,uintb in) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_CARRY behavior
@@ -234,6 +255,7 @@ class OpBehaviorIntNegate : public OpBehavior {
 public:
   OpBehaviorIntNegate(void): OpBehavior(CPUI_INT_NEGATE,true) {}	///< Constructor
   virtual uintb evaluateUnary(int4 sizeout,int4 sizein,uintb in1) const;
+  virtual void evaluateUnaryBatch(int4 sizeout,int4 sizein,const uintb *in1,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_XOR behavior
@@ -241,6 +263,7 @@ class OpBehaviorIntXor : public OpBehavior {
 public:
   OpBehaviorIntXor(void): OpBehavior(CPUI_INT_XOR,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_AND behavior
@@ -248,6 +271,7 @@ class OpBehaviorIntAnd : public OpBehavior {
 public:
   OpBehaviorIntAnd(void): OpBehavior(CPUI_INT_AND,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_OR behavior
@@ -255,6 +279,7 @@ class OpBehaviorIntOr : public OpBehavior {
 public:
   OpBehaviorIntOr(void): OpBehavior(CPUI_INT_OR,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_LEFT behavior
@@ -263,6 +288,7 @@ public:
   OpBehaviorIntLeft(void): OpBehavior(CPUI_INT_LEFT,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
   virtual uintb recoverInputBinary(int4 slot,int4 sizeout,uintb out,int4 sizein,uintb in) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_RIGHT behavior
@@ -271,6 +297,7 @@ public:
   OpBehaviorIntRight(void): OpBehavior(CPUI_INT_RIGHT,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
   virtual uintb recoverInputBinary(int4 slot,int4 sizeout,uintb out,int4 sizein,uintb in) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_SRIGHT behavior
@@ -286,6 +313,7 @@ class OpBehaviorIntMult : public OpBehavior {
 public:
   OpBehaviorIntMult(void): OpBehavior(CPUI_INT_MULT,false) {}	///< Constructor
   virtual uintb evaluateBinary(int4 sizeout,int4 sizein,uintb in1,uintb in2) const;
+  virtual void evaluateBinaryBatch(int4 sizeout,int4 sizein,const uintb *in1,const uintb *in2,uintb *out,int4 num) const;
 };
 
 /// CPUI_INT_DIV behavior
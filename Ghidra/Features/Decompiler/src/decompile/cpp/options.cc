@@ -17,6 +17,7 @@
 #include "funcdata.hh"
 #include "flow.hh"
 #include "printc.hh"
+#include "crc32.hh"
 
 /// If the parameter is "on" return \b true, if "off" return \b false.
 /// Any other value causes an exception.
@@ -49,6 +50,7 @@ OptionDatabase::OptionDatabase(Architecture *g)
 
 {
   glb = g;
+  confighash = 0;
   registerOption(new OptionExtraPop());
   registerOption(new OptionReadOnly());
   registerOption(new OptionIgnoreUnimplemented());
@@ -82,6 +84,8 @@ OptionDatabase::OptionDatabase(Architecture *g)
   registerOption(new OptionAliasBlock());
   registerOption(new OptionMaxInstruction());
   registerOption(new OptionNamespaceStrategy());
+  registerOption(new OptionParserCache());
+  registerOption(new OptionPartialRulePasses());
 }
 
 OptionDatabase::~OptionDatabase(void)
@@ -92,7 +96,9 @@ OptionDatabase::~OptionDatabase(void)
     delete (*iter).second;
 }
 
-/// Perform an \e option \e command directly, given its name and optional parameters
+/// Perform an \e option \e command directly, given its name and optional parameters.
+/// The command is folded into the configuration hash, so that the same sequence of commands
+/// always produces the same hash.
 /// \param nm is the registered name of the option
 /// \param p1 is the first optional parameter
 /// \param p2 is the second optional parameter
@@ -106,7 +112,15 @@ string OptionDatabase::set(const string &nm,const string &p1,const string &p2,co
   if (iter == optionmap.end())
     throw ParseError("Unknown option: "+nm);
   ArchOption *opt = (*iter).second;
-  return opt->apply(glb,p1,p2,p3);
+  string res = opt->apply(glb,p1,p2,p3);
+  const string *parts[4] = { &nm, &p1, &p2, &p3 };
+  for(int4 i=0;i<4;++i) {
+    const string &part( *parts[i] );
+    for(int4 j=0;j<part.size();++j)
+      confighash = crc_update(confighash,(uint1)part[j]);
+    confighash = crc_update(confighash,0);	// Separate the parameters
+  }
+  return res;
 }
 
 /// Unwrap the name and optional parameters and call method set()
@@ -854,3 +868,57 @@ string OptionNamespaceStrategy::apply(Architecture *glb,const string &p1,const s
   glb->print->setNamespaceStrategy(strategy);
   return "Namespace strategy set";
 }
+
+/// \class OptionParserCache
+/// \brief Set the size of the translator's cache of parsed instructions
+///
+/// The first parameter is the number of parsed instructions to keep. The optional second
+/// parameter is the size of the lookup hashtable, which must be a power of 2.
+/// A value of 0 restores the default for the processor.
+string OptionParserCache::apply(Architecture *glb,const string &p1,const string &p2,const string &p3) const
+
+{
+  if (p1.size() == 0)
+    throw ParseError("Must specify parser cache size");
+  int4 cachesize = -1;
+  int4 windowsize = 0;
+  istringstream s1(p1);
+  s1.unsetf(ios::dec | ios::hex | ios::oct); // Let user specify base
+  s1 >> cachesize;
+  if (cachesize < 0)
+    throw ParseError("Bad parsercache size parameter");
+  if (p2.size() != 0) {
+    windowsize = -1;
+    istringstream s2(p2);
+    s2.unsetf(ios::dec | ios::hex | ios::oct);
+    s2 >> windowsize;
+    if (windowsize < 0)
+      throw ParseError("Bad parsercache window parameter");
+  }
+  glb->translate->setParserCacheSize(cachesize,windowsize);
+  return "Parser cache size set";
+}
+
+/// \class OptionPartialRulePasses
+/// \brief Toggle whether repeat passes of a rule pool only examine modified PcodeOps
+///
+/// Setting the first parameter to "on" lets each ActionPool skip PcodeOps whose neighborhood has not
+/// changed since the last pass.  The pool still stops only after a full pass makes no change, but
+/// rules can fire in a different order, so the output is not guaranteed to be identical to the
+/// default, where every pass examines every PcodeOp.
+string OptionPartialRulePasses::apply(Architecture *glb,const string &p1,const string &p2,const string &p3) const
+
+{
+  bool val = onOrOff(p1);
+
+  string res;
+  if (val) {
+    res = "Repeat rule passes now only examine modified ops";
+    glb->partial_rule_passes = true;
+  }
+  else {
+    res = "Every rule pass now examines all ops";
+    glb->partial_rule_passes = false;
+  }
+  return res;
+}
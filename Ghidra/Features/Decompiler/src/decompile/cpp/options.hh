@@ -63,10 +63,12 @@ public:
 class OptionDatabase {
   Architecture *glb;				///< The Architecture affected by the contained ArchOption
   map<string,ArchOption *> optionmap;		///< A map from option name to registered ArchOption instance
+  uint4 confighash;				///< Running hash of every option command applied so far
   void registerOption(ArchOption *option);	///< Map from ArchOption name to its class instance
 public:
   OptionDatabase(Architecture *g);		///< Construct given the owning Architecture
   ~OptionDatabase(void);			///< Destructor
+  uint4 getConfigHash(void) const { return confighash; }	///< Get a hash summarizing the option commands applied
   string set(const string &nm,const string &p1="",const string &p2="",const string &p3="");	///< Issue an option command
   void parseOne(const Element *el);		///< Unwrap and execute a single option XML tag
   void restoreXml(const Element *el);		///< Execute a series of \e option \e commands passed by XML
@@ -276,4 +278,16 @@ public:
   virtual string apply(Architecture *glb,const string &p1,const string &p2,const string &p3) const;
 };
 
+class OptionParserCache : public ArchOption {
+public:
+  OptionParserCache(void) { name = "parsercache"; }	///< Constructor
+  virtual string apply(Architecture *glb,const string &p1,const string &p2,const string &p3) const;
+};
+
+class OptionPartialRulePasses : public ArchOption {
+public:
+  OptionPartialRulePasses(void) { name = "partialrulepasses"; }	///< Constructor
+  virtual string apply(Architecture *glb,const string &p1,const string &p2,const string &p3) const;
+};
+
 #endif
@@ -73,6 +73,7 @@ public:
   void applyForceGoto(Funcdata &data) const;
   bool hasFlowOverride(void) const { return (!flowoverride.empty()); }	///< Are there any flow overrides
   uint4 getFlowOverride(const Address &addr) const;
+  const map<Address,FuncProto *> &getProtoOverrides(void) const { return protoover; }	///< Get the prototype overrides by call-point
   void printRaw(ostream &s,Architecture *glb) const;
   void generateOverrideMessages(vector<string> &messagelist,Architecture *glb) const;
   void saveXml(ostream &s,Architecture *glb) const;
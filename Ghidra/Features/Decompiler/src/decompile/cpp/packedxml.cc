@@ -0,0 +1,542 @@
+/* ###
+ * IP: GHIDRA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "packedxml.hh"
+#include <cstring>
+#include <cctype>
+#include <fstream>
+#ifndef _WINDOWS
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+extern int4 convertEntityRef(const string &ref);
+extern int4 convertCharRef(const string &ref);
+
+/// The magic byte and version are written immediately.
+/// \param res is the string to hold the message
+PackedXmlWriter::PackedXmlWriter(string &res)
+  : out(res)
+
+{
+  depth = 0;
+  out += (char)magic;
+  out += (char)version;
+}
+
+/// \param val is the integer to write
+void PackedXmlWriter::writeVarint(uintb val)
+
+{
+  for(;;) {
+    uint1 b = 0x80 | (val & 0x3f);
+    val >>= 6;
+    if (val == 0) {
+      out += (char)b;
+      return;
+    }
+    out += (char)(b | 0x40);
+  }
+}
+
+/// The first time a string is written, its bytes are sent and it becomes the next entry
+/// of the table. After that, only its index is sent.
+/// \param str is the string to write
+void PackedXmlWriter::writeString(const string &str)
+
+{
+  map<string,int4>::const_iterator iter = table.find(str);
+  if (iter != table.end()) {
+    out += (char)string_ref;
+    writeVarint((*iter).second);
+    return;
+  }
+  int4 index = table.size();
+  table[str] = index;
+  out += (char)string_define;
+  writeVarint(str.size());
+  out += str;
+}
+
+/// Integers in canonical form are sent as variable length integers, anything else as a string.
+/// Long character content is sent as a literal rather than a table entry, as it is unlikely to repeat.
+/// \param val is the value to write
+void PackedXmlWriter::writeValue(const string &val)
+
+{
+  uintb num;
+  if (isHex(val,num)) {
+    out += (char)value_hex;
+    writeVarint(num);
+  }
+  else if (isDecimal(val,0,num)) {
+    out += (char)value_dec;
+    writeVarint(num);
+  }
+  else if (val.size() > 1 && val[0] == '-' && isDecimal(val,1,num)) {
+    out += (char)value_negdec;
+    writeVarint(num);
+  }
+  else {
+    out += (char)value_string;
+    if (val.size() > 64) {
+      out += (char)string_literal;
+      writeVarint(val.size());
+      out += val;
+    }
+    else
+      writeString(val);
+  }
+}
+
+/// The value must be exactly what a_v_u() writes: "0x" followed by lower case hex digits,
+/// with no leading zeros.
+/// \param val is the attribute value
+/// \param res will hold the integer if the test succeeds
+/// \return \b true if the value is a canonical hex integer
+bool PackedXmlWriter::isHex(const string &val,uintb &res)
+
+{
+  int4 sz = val.size();
+  if (sz < 3 || sz > 18) return false;
+  if (val[0] != '0' || val[1] != 'x') return false;
+  if (val[2] == '0' && sz != 3) return false;
+  res = 0;
+  for(int4 i=2;i<sz;++i) {
+    char c = val[i];
+    res <<= 4;
+    if (c >= '0' && c <= '9')
+      res |= c - '0';
+    else if (c >= 'a' && c <= 'f')
+      res |= c - 'a' + 10;
+    else
+      return false;
+  }
+  return true;
+}
+
+/// The digits must have no leading zeros, and there must be few enough of them that
+/// the integer cannot overflow.
+/// \param val is the attribute value
+/// \param start is the index of the first digit
+/// \param res will hold the integer if the test succeeds
+/// \return \b true if the value is a canonical decimal integer
+bool PackedXmlWriter::isDecimal(const string &val,int4 start,uintb &res)
+
+{
+  int4 sz = val.size();
+  if (sz <= start || sz - start > 18) return false;
+  if (val[start] == '0' && sz != start + 1) return false;
+  res = 0;
+  for(int4 i=start;i<sz;++i) {
+    char c = val[i];
+    if (c < '0' || c > '9') return false;
+    res = res * 10 + (c - '0');
+  }
+  return true;
+}
+
+/// The reference is converted to a character the same way the XML parser converts it.
+/// \param ptr points to the '&' starting the reference and is advanced past the ';'
+/// \param end is the end of the XML text
+/// \param res is the string to append the character to
+void PackedXmlWriter::decodeEntity(const char *&ptr,const char *end,string &res)
+
+{
+  const char *start = ++ptr;
+  while(ptr < end && *ptr != ';')
+    ++ptr;
+  if (ptr == end || ptr == start)
+    transcodeError("Bad reference");
+  string ref(start,ptr - start);
+  ++ptr;
+  if (ref[0] == '#') {
+    if (ref.size() == 1)
+      transcodeError("Bad character reference");
+    res += (char)convertCharRef(ref.substr(1));
+  }
+  else {
+    int4 c = convertEntityRef(ref);
+    if (c == -1)
+      transcodeError("Unknown entity: " + ref);
+    res += (char)c;
+  }
+}
+
+/// \param msg is the description of the problem
+void PackedXmlWriter::transcodeError(const string &msg)
+
+{
+  throw XmlError("Packed transcode: " + msg);
+}
+
+/// \param name is the name of the element
+void PackedXmlWriter::startElement(const string &name)
+
+{
+  out += (char)elem_start;
+  writeString(name);
+  depth += 1;
+}
+
+/// \param name is the name of the attribute
+/// \param val is the (unescaped) attribute value
+void PackedXmlWriter::addAttribute(const string &name,const string &val)
+
+{
+  out += (char)attribute;
+  writeString(name);
+  writeValue(val);
+}
+
+/// \param text is the (unescaped) character data
+void PackedXmlWriter::addContent(const string &text)
+
+{
+  if (text.empty()) return;
+  out += (char)content;
+  writeValue(text);
+}
+
+void PackedXmlWriter::endElement(void)
+
+{
+  out += (char)elem_end;
+  depth -= 1;
+}
+
+/// \param el is the root of the tree to write
+void PackedXmlWriter::writeElement(const Element *el)
+
+{
+  startElement(el->getName());
+  for(int4 i=0;i<el->getNumAttributes();++i)
+    addAttribute(el->getAttributeName(i),el->getAttributeValue(i));
+  addContent(el->getContent());
+  const List &list(el->getChildren());
+  for(List::const_iterator iter=list.begin();iter!=list.end();++iter)
+    writeElement(*iter);
+  endElement();
+}
+
+/// The text is scanned once, without building a DOM tree. Only the subset of XML that
+/// the decompiler and the client produce is supported: elements, attributes, character
+/// data and references, CDATA sections, comments, and processing instructions, which are
+/// skipped along with any document type declaration.  Character data between two tags is
+/// sent as one piece of content, including any whitespace.
+/// \param xml is the XML document text
+/// \param len is the number of characters in the text
+void PackedXmlWriter::transcode(const char *xml,int4 len)
+
+{
+  const char *ptr = xml;
+  const char *end = xml + len;
+  string text;
+  string name;
+  string val;
+
+  while(ptr < end && *ptr != '\0') {
+    if (*ptr == '&') {
+      decodeEntity(ptr,end,text);
+      continue;
+    }
+    if (*ptr != '<') {
+      text += *ptr++;
+      continue;
+    }
+    ++ptr;
+    if (ptr == end) transcodeError("Unexpected end of document");
+    if (*ptr == '?' || *ptr == '!') {
+      const char *term;
+      if (end - ptr >= 8 && string(ptr,8) == "![CDATA[") {
+	ptr += 8;
+	const char *start = ptr;
+	while(ptr + 2 < end && !(ptr[0] == ']' && ptr[1] == ']' && ptr[2] == '>'))
+	  ++ptr;
+	text.append(start,ptr - start);
+	term = "]]>";
+      }
+      else if (end - ptr >= 3 && string(ptr,3) == "!--")
+	term = "-->";
+      else if (*ptr == '?')
+	term = "?>";
+      else
+	term = ">";
+      int4 termlen = strlen(term);
+      while(ptr < end && string(ptr,min((int4)(end-ptr),termlen)) != term)
+	++ptr;
+      if (ptr == end) transcodeError("Unterminated markup");
+      ptr += termlen;
+      continue;
+    }
+    if (depth > 0)
+      addContent(text);
+    text.clear();
+    if (*ptr == '/') {		// End tag
+      while(ptr < end && *ptr != '>')
+	++ptr;
+      if (ptr == end || depth == 0) transcodeError("Bad end tag");
+      ++ptr;
+      endElement();
+      continue;
+    }
+    name.clear();
+    while(ptr < end && !isspace(*ptr) && *ptr != '/' && *ptr != '>')
+      name += *ptr++;
+    if (name.empty()) transcodeError("Missing element name");
+    startElement(name);
+    for(;;) {
+      while(ptr < end && isspace(*ptr))
+	++ptr;
+      if (ptr == end) transcodeError("Unterminated tag");
+      if (*ptr == '>') {
+	++ptr;
+	break;
+      }
+      if (*ptr == '/') {
+	++ptr;
+	if (ptr == end || *ptr != '>') transcodeError("Bad empty element tag");
+	++ptr;
+	endElement();
+	break;
+      }
+      name.clear();
+      while(ptr < end && !isspace(*ptr) && *ptr != '=')
+	name += *ptr++;
+      while(ptr < end && isspace(*ptr))
+	++ptr;
+      if (ptr == end || *ptr != '=') transcodeError("Missing '=' after attribute " + name);
+      ++ptr;
+      while(ptr < end && isspace(*ptr))
+	++ptr;
+      if (ptr == end || (*ptr != '"' && *ptr != '\'')) transcodeError("Missing attribute quote");
+      char quote = *ptr++;
+      val.clear();
+      while(ptr < end && *ptr != quote) {
+	if (*ptr == '&')
+	  decodeEntity(ptr,end,val);
+	else
+	  val += *ptr++;
+      }
+      if (ptr == end) transcodeError("Unterminated attribute value");
+      ++ptr;
+      addAttribute(name,val);
+    }
+  }
+  if (depth != 0)
+    transcodeError("Unclosed elements at end of document");
+}
+
+/// \return the integer
+uintb PackedXmlReader::readVarint(void)
+
+{
+  uintb res = 0;
+  int4 shift = 0;
+  for(;;) {
+    if (ptr == end)
+      throw XmlError("Packed decode: Unexpected end of message");
+    uint1 b = *ptr++;
+    if ((b & 0x80) == 0)
+      throw XmlError("Packed decode: Bad integer");
+    res |= ((uintb)(b & 0x3f)) << shift;
+    if ((b & 0x40) == 0) break;
+    shift += 6;
+  }
+  return res;
+}
+
+/// \return a reference to the string, which remains valid until the next read
+const string &PackedXmlReader::readString(void)
+
+{
+  if (ptr == end)
+    throw XmlError("Packed decode: Unexpected end of message");
+  uint1 tok = *ptr++;
+  if (tok == PackedXmlWriter::string_ref) {
+    uintb index = readVarint();
+    if (index >= table.size())
+      throw XmlError("Packed decode: Bad string index");
+    return table[index];
+  }
+  if (tok != PackedXmlWriter::string_define && tok != PackedXmlWriter::string_literal)
+    throw XmlError("Packed decode: Expecting string");
+  uintb len = readVarint();
+  if (len > (uintb)(end - ptr))
+    throw XmlError("Packed decode: Unexpected end of message");
+  const char *start = (const char *)ptr;
+  ptr += len;
+  if (tok == PackedXmlWriter::string_literal) {
+    scratch.assign(start,len);
+    return scratch;
+  }
+  table.push_back(string(start,len));
+  return table.back();
+}
+
+/// Integer values are rendered back in the same canonical form they were sent from.
+/// \param res will hold the value
+void PackedXmlReader::readValue(string &res)
+
+{
+  if (ptr == end)
+    throw XmlError("Packed decode: Unexpected end of message");
+  uint1 tok = *ptr++;
+  if (tok == PackedXmlWriter::value_string) {
+    res = readString();
+    return;
+  }
+  char buf[24];
+  char *p = buf + sizeof(buf);	// Digits are written backward from the end of the buffer
+  uintb val = readVarint();
+  switch(tok) {
+  case PackedXmlWriter::value_hex:
+    do {
+      *--p = "0123456789abcdef"[val & 0xf];
+      val >>= 4;
+    } while(val != 0);
+    *--p = 'x';
+    *--p = '0';
+    break;
+  case PackedXmlWriter::value_dec:
+  case PackedXmlWriter::value_negdec:
+    do {
+      *--p = '0' + (val % 10);
+      val /= 10;
+    } while(val != 0);
+    if (tok == PackedXmlWriter::value_negdec)
+      *--p = '-';
+    break;
+  default:
+    throw XmlError("Packed decode: Bad value");
+  }
+  res.assign(p,buf + sizeof(buf) - p);
+}
+
+/// \return the new document, owned by the caller
+Document *PackedXmlReader::readDocument(void)
+
+{
+  if (end - ptr < 2 || ptr[0] != PackedXmlWriter::magic)
+    throw XmlError("Packed decode: Missing magic");
+  if (ptr[1] != PackedXmlWriter::version)
+    throw XmlError("Packed decode: Unsupported version");
+  ptr += 2;
+  Document *doc = new Document();
+  Element *cur = doc;
+  string val;
+  try {
+    while(ptr < end) {
+      uint1 tok = *ptr++;
+      switch(tok) {
+      case PackedXmlWriter::elem_start:
+      {
+	Element *newel = new Element(cur);
+	cur->addChild(newel);
+	cur = newel;
+	newel->setName(readString());
+	break;
+      }
+      case PackedXmlWriter::elem_end:
+	if (cur == doc)
+	  throw XmlError("Packed decode: Unbalanced element end");
+	cur = cur->getParent();
+	break;
+      case PackedXmlWriter::attribute:
+      {
+	string nm = readString();
+	readValue(val);
+	cur->addAttribute(nm,val);
+	break;
+      }
+      case PackedXmlWriter::content:
+	readValue(val);
+	if (val.find_first_not_of(" \n\r\t") != string::npos)
+	  cur->addContent(val.c_str(),0,val.size());
+	break;
+      default:
+	throw XmlError("Packed decode: Bad token");
+      }
+    }
+    if (cur != doc || doc->getChildren().empty())
+      throw XmlError("Packed decode: Incomplete document");
+  }
+  catch(XmlError &err) {
+    delete doc;
+    throw;
+  }
+  return doc;
+}
+
+void packed_transcode(const string &xml,string &res)
+
+{
+  PackedXmlWriter writer(res);
+  writer.transcode(xml.c_str(),xml.size());
+}
+
+Document *packed_tree(const string &buf)
+
+{
+  PackedXmlReader reader((const uint1 *)buf.c_str(),buf.size());
+  return reader.readDocument();
+}
+
+Document *packed_file(const string &filename)
+
+{
+#ifdef _WINDOWS
+  ifstream s(filename.c_str(),ios::in|ios::binary);
+  if (!s)
+    throw XmlError("Unable to open packed document "+filename);
+  string buf;
+  s.seekg(0,ios::end);
+  streamoff size = s.tellg();
+  s.seekg(0,ios::beg);
+  if (size > 0) {
+    buf.resize(size);
+    s.read(&buf[0],size);
+    buf.resize(s.gcount());
+  }
+  s.close();
+  return packed_tree(buf);
+#else
+  int fd = open(filename.c_str(),O_RDONLY);
+  if (fd < 0)
+    throw XmlError("Unable to open packed document "+filename);
+  struct stat st;
+  if (fstat(fd,&st) != 0 || st.st_size == 0) {
+    close(fd);
+    throw XmlError("Unable to read packed document "+filename);
+  }
+  void *map = mmap((void *)0,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+  close(fd);			// The mapping keeps its own reference to the file
+  if (map == MAP_FAILED)
+    throw XmlError("Unable to map packed document "+filename);
+  Document *doc;
+  try {
+    PackedXmlReader reader((const uint1 *)map,st.st_size);
+    doc = reader.readDocument();
+  }
+  catch(XmlError &err) {
+    munmap(map,st.st_size);
+    throw;
+  }
+  munmap(map,st.st_size);
+  return doc;
+#endif
+}
@@ -0,0 +1,124 @@
+/* ###
+ * IP: GHIDRA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/// \file packedxml.hh
+/// \brief A compact binary encoding of XML documents for the Ghidra client protocol
+#ifndef __CPUI_PACKEDXML__
+#define __CPUI_PACKEDXML__
+
+#include "xml.hh"
+
+/// \brief Writer for the \e packed encoding of an XML document
+///
+/// The packed encoding carries the same tree as the XML text: element starts and ends,
+/// attributes, and character content.  Element and attribute names, and attribute values that
+/// are not integers, are written into a string table the first time they are seen and referred
+/// to by index afterward.  Attribute values that are integers in the canonical form written by
+/// a_v_u() or a_v_i() are written as variable length integers and rendered back in exactly the
+/// same form when decoded. The table lives for a single message.
+///
+/// No byte of the encoding is zero, so a packed message can be sent as the body of a string in
+/// the 0/1 burst framing of the protocol.  A message starts with the \b magic byte, which can
+/// never start an XML document, so a reader can tell the two encodings apart from the first byte.
+///
+/// A variable length integer is sent 6 bits per byte, least significant bits first.  Each byte
+/// has bit 7 set and has bit 6 set if more bytes follow.
+class PackedXmlWriter {
+public:
+  /// \brief Bytes making up the packed encoding
+  enum {
+    magic = 0x7f,		///< First byte of a packed message
+    version = 0x01,		///< Version of the encoding, second byte of the message
+    elem_start = 0x02,		///< Start of an element, followed by a string holding its name
+    elem_end = 0x03,		///< End of the current element
+    attribute = 0x04,		///< Attribute of the current element, followed by a name string and a value
+    content = 0x05,		///< Character content of the current element, followed by a value
+    value_string = 0x10,	///< Value is a string
+    value_hex = 0x11,		///< Value is an unsigned integer written in hex with a "0x" prefix
+    value_dec = 0x12,		///< Value is an unsigned integer written in decimal
+    value_negdec = 0x13,	///< Value is a negative integer written in decimal (the magnitude is sent)
+    string_ref = 0x20,		///< String is the table entry with the following index
+    string_define = 0x21,	///< String follows as a length and raw bytes, and is the next table entry
+    string_literal = 0x22	///< String follows as a length and raw bytes, and is not put in the table
+  };
+private:
+  string &out;			///< The encoded message being built
+  map<string,int4> table;	///< String table built up so far
+  int4 depth;			///< Number of elements currently open
+  void writeVarint(uintb val);	///< Write a variable length integer
+  void writeString(const string &str);	///< Write a string by table reference, defining it if necessary
+  void writeValue(const string &val);	///< Write an attribute value or character content
+  static bool isHex(const string &val,uintb &res);		///< Test for a canonical hex integer
+  static bool isDecimal(const string &val,int4 start,uintb &res);	///< Test for a canonical decimal integer
+  static void decodeEntity(const char *&ptr,const char *end,string &res);	///< Decode a reference in character data
+  static void transcodeError(const string &msg);	///< Throw an exception for badly formed XML text
+public:
+  PackedXmlWriter(string &res);				///< Start a packed message in the given string
+  void startElement(const string &name);		///< Start a new element
+  void addAttribute(const string &name,const string &val);	///< Add an attribute to the element just started
+  void addContent(const string &text);			///< Add character content to the current element
+  void endElement(void);				///< End the current element
+  void writeElement(const Element *el);			///< Write an element and its children from a DOM tree
+  void transcode(const char *xml,int4 len);		///< Write a document given as XML text
+};
+
+/// \brief Reader that builds an in-memory DOM tree from a \e packed message
+///
+/// Character content that is all whitespace is dropped, as the XML parser does.
+class PackedXmlReader {
+  const uint1 *ptr;		///< Next byte to read
+  const uint1 *end;		///< End of the message
+  vector<string> table;		///< String table built up so far
+  string scratch;		///< Holds the most recent string literal
+  uintb readVarint(void);	///< Read a variable length integer
+  const string &readString(void);	///< Read a string reference, definition, or literal
+  void readValue(string &res);	///< Read an attribute value or character content
+public:
+  PackedXmlReader(const uint1 *buf,int4 len) { ptr = buf; end = buf + len; }	///< Constructor given the message bytes
+  Document *readDocument(void);	///< Decode the message into a new document
+};
+
+/// \brief Test if a buffer starts with a packed message
+///
+/// \param buf is the buffer
+/// \param len is the number of bytes in the buffer
+/// \return \b true if the buffer holds a packed message
+inline bool packed_isencoded(const char *buf,int4 len)
+
+{
+  return (len > 0 && (uint1)buf[0] == PackedXmlWriter::magic);
+}
+
+/// \brief Transcode the given XML document text into the packed encoding
+///
+/// \param xml is the XML document text
+/// \param res will hold the packed message
+extern void packed_transcode(const string &xml,string &res);
+
+/// \brief Decode the given packed message into an in-memory document
+///
+/// \param buf is the packed message
+/// \return the in-memory XML document
+extern Document *packed_tree(const string &buf);
+
+/// \brief Decode the packed message held in the given file into an in-memory document
+///
+/// Where the platform supports it, the file is memory-mapped and decoded in place, so the
+/// encoded bytes are never copied onto the heap.  The mapping is released before returning.
+/// \param filename is the path of the file
+/// \return the in-memory XML document
+extern Document *packed_file(const string &filename);
+
+#endif
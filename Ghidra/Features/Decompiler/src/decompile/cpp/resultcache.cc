@@ -0,0 +1,619 @@
+/* ###
+ * IP: GHIDRA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "resultcache.hh"
+#include "funcdata.hh"
+
+/// Bytes are folded in with the 64-bit FNV-1a hash.
+/// \param h is the running hash
+/// \param ptr points to the bytes to fold in
+/// \param size is the number of bytes
+/// \return the updated hash
+uint8 ResultCache::hashBytes(uint8 h,const uint1 *ptr,int4 size)
+
+{
+  for(int4 i=0;i<size;++i) {
+    h ^= ptr[i];
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+/// The string is followed by a terminator, so that consecutive strings cannot run together.
+/// \param h is the running hash
+/// \param str is the string to fold in
+/// \return the updated hash
+uint8 ResultCache::hashString(uint8 h,const string &str)
+
+{
+  h = hashBytes(h,(const uint1 *)str.c_str(),str.size());
+  uint1 term = 0;
+  return hashBytes(h,&term,1);
+}
+
+/// Pointers, arrays, structure fields and function prototypes are followed, so that a change
+/// to any component of a data-type is seen as a change to the data-type.  Each data-type is
+/// added to the list once, in the order it is first reached.
+/// \param ct is the data-type to gather
+/// \param res is the list of data-types gathered so far
+/// \param seen is the set of data-types already in the list
+void ResultCache::collectType(Datatype *ct,vector<Datatype *> &res,set<Datatype *> &seen)
+
+{
+  if (ct == (Datatype *)0) return;
+  if (!seen.insert(ct).second) return;
+  res.push_back(ct);
+  switch(ct->getMetatype()) {
+  case TYPE_PTR:
+    collectType(((TypePointer *)ct)->getPtrTo(),res,seen);
+    break;
+  case TYPE_ARRAY:
+    collectType(((TypeArray *)ct)->getBase(),res,seen);
+    break;
+  case TYPE_STRUCT:
+    {
+      TypeStruct *st = (TypeStruct *)ct;
+      vector<TypeField>::const_iterator iter;
+      for(iter=st->beginField();iter!=st->endField();++iter)
+	collectType((*iter).type,res,seen);
+      break;
+    }
+  case TYPE_CODE:
+    collectProtoTypes(((TypeCode *)ct)->getPrototype(),res,seen);
+    break;
+  default:
+    break;
+  }
+}
+
+/// \param proto is the prototype, which may be null
+/// \param res is the list of data-types gathered so far
+/// \param seen is the set of data-types already in the list
+void ResultCache::collectProtoTypes(const FuncProto *proto,vector<Datatype *> &res,set<Datatype *> &seen)
+
+{
+  if (proto == (const FuncProto *)0) return;
+  collectType(proto->getOutputType(),res,seen);
+  for(int4 i=0;i<proto->numParams();++i)
+    collectType(proto->getParam(i)->getType(),res,seen);
+}
+
+/// Symbols and prototypes only refer to named data-types by name, so the full definition
+/// of each data-type is hashed separately.
+/// \param h is the running hash
+/// \param types is the list of data-types to fold in
+/// \return the updated hash
+uint8 ResultCache::hashTypes(uint8 h,const vector<Datatype *> &types)
+
+{
+  for(int4 i=0;i<types.size();++i) {
+    ostringstream s;
+    types[i]->saveXml(s);
+    h = hashString(h,s.str());
+  }
+  return h;
+}
+
+/// The configuration is the root Action, the output language, every option command
+/// applied to the Architecture, the memory properties (\e volatile, \e read-only, etc.)
+/// and the address ranges owned by the global scope.
+/// \return the hash of the configuration
+uint8 ResultCache::hashConfig(void) const
+
+{
+  uint8 h = 0xcbf29ce484222325ULL;
+  h = hashString(h,glb->allacts.getCurrentName());
+  h = hashString(h,glb->print->getName());
+  uint4 opthash = glb->options->getConfigHash();
+  h = hashBytes(h,(const uint1 *)&opthash,sizeof(uint4));
+
+  const partmap<Address,uint4> &props( glb->symboltab->getProperties() );
+  uint4 val = props.defaultValue();
+  h = hashBytes(h,(const uint1 *)&val,sizeof(uint4));
+  partmap<Address,uint4>::const_iterator piter;
+  for(piter=props.begin();piter!=props.end();++piter) {
+    const Address &addr( (*piter).first );
+    uintb off = addr.getOffset();
+    val = (*piter).second;
+    h = hashString(h,addr.isInvalid() ? "" : addr.getSpace()->getName());
+    h = hashBytes(h,(const uint1 *)&off,sizeof(uintb));
+    h = hashBytes(h,(const uint1 *)&val,sizeof(uint4));
+  }
+
+  ostringstream s;
+  glb->symboltab->getGlobalScope()->printBounds(s);
+  return hashString(h,s.str());
+}
+
+/// The bytes are read through the LoadImage.  An exception is thrown if any of them
+/// are not available.  The low-level context values are hashed across each range, along
+/// with every point within the range where they change, and the tracked register values
+/// at the entry point of the function are hashed.
+/// \param entry is the entry point of the function
+/// \param ranges is the list of address ranges to hash
+/// \return the hash of the bytes and context in every range
+uint8 ResultCache::hashRanges(const Address &entry,const vector<Range> &ranges) const
+
+{
+  uint8 h = 0xcbf29ce484222325ULL;
+  vector<uint1> buf;
+  int4 contextsize = glb->context->getContextSize();
+  for(int4 i=0;i<ranges.size();++i) {
+    const Range &range( ranges[i] );
+    int4 size = (int4)(range.getLast() - range.getFirst() + 1);
+    buf.resize(size);
+    glb->loader->loadFill(&buf[0],size,range.getFirstAddr());
+    h = hashBytes(h,(const uint1 *)&size,sizeof(int4));
+    h = hashBytes(h,&buf[0],size);
+
+    uintb off = range.getFirst();
+    for(;;) {
+      uintb first,last;
+      const uintm *ctx = glb->context->getContext(Address(range.getSpace(),off),first,last);
+      h = hashBytes(h,(const uint1 *)&off,sizeof(uintb));
+      h = hashBytes(h,(const uint1 *)ctx,contextsize * sizeof(uintm));
+      if (last >= range.getLast()) break;
+      off = last + 1;
+    }
+  }
+  ostringstream s;
+  const TrackedSet &tracked( glb->context->getTrackedSet(entry) );
+  for(int4 i=0;i<tracked.size();++i)
+    tracked[i].saveXml(s);
+  return hashString(h,s.str());
+}
+
+/// For a called function, its name and prototype are hashed.  For a global variable, the
+/// Symbol containing the address is hashed.  An address with no function or Symbol still
+/// contributes to the hash, so that adding one is detected.  The full definition of every
+/// data-type reachable from the prototypes and Symbols is hashed as well.  For a string literal,
+/// the decoded string data is hashed, which is empty if the bytes no longer form a string.
+/// \param rec is the record holding the dependencies
+/// \return the hash of the symbols and string data at the addresses
+uint8 ResultCache::hashDependencies(const ResultCacheRecord &rec) const
+
+{
+  uint8 h = 0xcbf29ce484222325ULL;
+  vector<Datatype *> types;
+  set<Datatype *> seen;
+  Scope *globalscope = glb->symboltab->getGlobalScope();
+  for(int4 i=0;i<rec.calls.size();++i) {
+    Scope *scope = glb->symboltab->mapScope(globalscope,rec.calls[i],Address());
+    Funcdata *callee = scope->queryFunction(rec.calls[i]);
+    if (callee == (Funcdata *)0) {
+      h = hashString(h,"");
+      continue;
+    }
+    ostringstream s;
+    s << callee->getName();
+    callee->getFuncProto().saveXml(s);
+    h = hashString(h,s.str());
+    collectProtoTypes(&callee->getFuncProto(),types,seen);
+  }
+  for(int4 i=0;i<rec.globals.size();++i) {
+    Scope *scope = glb->symboltab->mapScope(globalscope,rec.globals[i],Address());
+    SymbolEntry *entry = scope->queryContainer(rec.globals[i],1,Address());
+    if (entry == (SymbolEntry *)0) {
+      h = hashString(h,"");
+      continue;
+    }
+    ostringstream s;
+    entry->getSymbol()->saveXml(s);
+    h = hashString(h,s.str());
+    collectType(entry->getSymbol()->getType(),types,seen);
+  }
+  for(int4 i=0;i<rec.strings.size();++i) {
+    Datatype *chartype = glb->types->getBase(rec.strings[i].second,TYPE_INT);
+    bool isTrunc = false;
+    const vector<uint1> &buffer( glb->stringManager->getStringData(rec.strings[i].first,chartype,isTrunc) );
+    uint1 trunc = isTrunc ? 1 : 0;
+    int4 size = buffer.size();
+    h = hashBytes(h,&trunc,1);
+    h = hashBytes(h,(const uint1 *)&size,sizeof(int4));
+    if (size > 0)
+      h = hashBytes(h,&buffer[0],size);
+  }
+  return hashTypes(h,types);
+}
+
+/// This mirrors the way PrintC::pushConstant() and PrintC::opPtrsub() turn a constant into a
+/// name or a string literal:
+///   - the offset of a PTRSUB off the global spacebase is the address of a global variable
+///   - a pointer to code is the entry point of a function
+///   - a pointer to characters, into read-only memory, is a string literal
+///
+/// Addresses are recorded whether or not a Symbol, function, or string is currently present,
+/// so that one appearing later is detected.
+/// \param op is the PcodeOp reading the constant
+/// \param slot is the input slot of the constant
+/// \param calls collects entry points of functions
+/// \param globals collects addresses of global variables
+/// \param strings collects the address and character size of string literals
+void ResultCache::collectConstant(const PcodeOp *op,int4 slot,set<Address> &calls,set<Address> &globals,
+				  set<pair<Address,int4> > &strings) const
+{
+  const Varnode *vn = op->getIn(slot);
+  if (op->code() == CPUI_PTRSUB && slot == 1) {
+    Datatype *ct = op->getIn(0)->getHigh()->getType();
+    if (ct->getMetatype() != TYPE_PTR) return;
+    ct = ((TypePointer *)ct)->getPtrTo();
+    if (ct->getMetatype() != TYPE_SPACEBASE) return;
+    TypeSpacebase *sb = (TypeSpacebase *)ct;
+    if (!sb->getMap()->isGlobal()) return;
+    Address addr = sb->getAddress(vn->getOffset(),op->getIn(0)->getSize(),op->getAddr());
+    if (!addr.isInvalid())
+      globals.insert(addr);
+    return;
+  }
+  Datatype *ct = vn->getHigh()->getType();
+  if (ct->getMetatype() != TYPE_PTR) return;
+  uintb val = vn->getOffset();
+  if (val == 0) return;
+  Datatype *subtype = ((TypePointer *)ct)->getPtrTo();
+  if (subtype->getMetatype() == TYPE_CODE) {
+    AddrSpace *spc = glb->getDefaultCodeSpace();
+    Address addr(spc,AddrSpace::addressToByte(val,spc->getWordSize()));
+    if (addr != op->getParent()->getFuncdata()->getAddress())
+      calls.insert(addr);
+  }
+  else if (subtype->isCharPrint() && !subtype->isOpaqueString()) {
+    uintb fullEncoding;
+    Address addr = glb->resolveConstant(glb->getDefaultDataSpace(),val,ct->getSize(),op->getAddr(),fullEncoding);
+    if (addr.isInvalid()) return;
+    if (!glb->symboltab->getGlobalScope()->isReadOnly(addr,1,Address())) return;
+    strings.insert(pair<Address,int4>(addr,subtype->getSize()));
+  }
+}
+
+/// The body of the function is taken as the original address ranges of its basic blocks.
+/// Dependencies are everything outside the function that the printer may use:
+///   - the entry points of called functions, other than the function itself, which is covered
+///     by hashInputs()
+///   - the addresses of persistent Varnodes in the default data space
+///   - the storage address of any global Symbol attached to a variable of the function
+///   - whatever a constant may be printed as, see collectConstant()
+/// \param fd is the decompiled function
+/// \param rec is the record to fill in
+void ResultCache::collectDependencies(Funcdata *fd,ResultCacheRecord &rec) const
+
+{
+  RangeList body;
+  const BlockGraph &graph( fd->getBasicBlocks() );
+  for(int4 i=0;i<graph.getSize();++i) {
+    BlockBasic *bb = (BlockBasic *)graph.getBlock(i);
+    Address start = bb->getStart();
+    Address stop = bb->getStop();
+    if (start.isInvalid() || stop.isInvalid()) continue;
+    if (start.getSpace() != stop.getSpace() || stop.getOffset() < start.getOffset()) continue;
+    body.insertRange(start.getSpace(),start.getOffset(),stop.getOffset());
+  }
+  set<Range>::const_iterator riter;
+  for(riter=body.begin();riter!=body.end();++riter)
+    rec.ranges.push_back(*riter);
+
+  set<Address> calls;
+  for(int4 i=0;i<fd->numCalls();++i) {
+    const Address &addr( fd->getCallSpecs(i)->getEntryAddress() );
+    if (addr.isInvalid() || addr == fd->getAddress()) continue;
+    calls.insert(addr);
+  }
+
+  set<Address> globals;
+  set<pair<Address,int4> > strings;
+  AddrSpace *spc = glb->getDefaultDataSpace();
+  VarnodeLocSet::const_iterator iter = fd->beginLoc(spc);
+  VarnodeLocSet::const_iterator enditer = fd->endLoc(spc);
+  for(;iter!=enditer;++iter) {
+    Varnode *vn = *iter;
+    if (vn->isPersist())
+      globals.insert(vn->getAddr());
+  }
+
+  list<PcodeOp *>::const_iterator oiter;
+  for(oiter=fd->beginOpAlive();oiter!=fd->endOpAlive();++oiter) {
+    PcodeOp *op = *oiter;
+    for(int4 i=-1;i<op->numInput();++i) {
+      Varnode *vn = (i < 0) ? op->getOut() : op->getIn(i);
+      if (vn == (Varnode *)0 || vn->isAnnotation()) continue;
+      Symbol *sym = vn->getHigh()->getSymbol();
+      if (sym != (Symbol *)0 && sym->getScope()->isGlobal() && sym->numEntries() > 0)
+	globals.insert(sym->getFirstWholeMap()->getAddr());
+      if (vn->isConstant())
+	collectConstant(op,i,calls,globals,strings);
+    }
+  }
+  rec.calls.insert(rec.calls.end(),calls.begin(),calls.end());
+  rec.globals.insert(rec.globals.end(),globals.begin(),globals.end());
+  rec.strings.insert(rec.strings.end(),strings.begin(),strings.end());
+}
+
+/// \param fd is the function being looked up
+/// \param inputhash is the current hash of the function's own inputs
+/// \param stale is set to \b true if a record exists but its inputs have changed
+/// \return the matching record or null
+const ResultCacheRecord *ResultCache::findValid(Funcdata *fd,uint8 inputhash,bool &stale) const
+
+{
+  stale = false;
+  map<Address,ResultCacheRecord>::const_iterator iter = records.find(fd->getAddress());
+  if (iter == records.end())
+    return (const ResultCacheRecord *)0;
+  const ResultCacheRecord &rec( (*iter).second );
+  stale = true;
+  if (rec.inputhash != inputhash || rec.confighash != hashConfig())
+    return (const ResultCacheRecord *)0;
+  try {
+    if (rec.byteshash != hashRanges(fd->getAddress(),rec.ranges))
+      return (const ResultCacheRecord *)0;
+    if (rec.depshash != hashDependencies(rec))
+      return (const ResultCacheRecord *)0;
+  }
+  catch(LowlevelError &err) {	// Bytes are no longer available
+    return (const ResultCacheRecord *)0;
+  }
+  stale = false;
+  return &rec;
+}
+
+/// \param s is the stream to write to
+/// \param addr is the address to write
+void ResultCache::saveAddress(ostream &s,const Address &addr) const
+
+{
+  s << addr.getSpace()->getName() << ' ' << hex << addr.getOffset();
+}
+
+/// \param s is the stream to read from
+/// \return the address read
+Address ResultCache::restoreAddress(istream &s) const
+
+{
+  string spcname;
+  uintb off;
+  s >> ws >> spcname >> ws >> hex >> off;
+  AddrSpace *spc = glb->getSpaceByName(spcname);
+  if (spc == (AddrSpace *)0)
+    throw LowlevelError("Unknown address space in result cache: "+spcname);
+  return Address(spc,off);
+}
+
+/// Records are read in order, so a later record for the same function replaces an earlier one.
+/// Reading stops at the first record that cannot be parsed, either because an append was
+/// interrupted or because it was written in an older layout.  The file is then cut back to the
+/// last complete record, so that records appended later can be read.  A missing file is treated
+/// as an empty cache.
+void ResultCache::load(void)
+
+{
+  ifstream f(filename.c_str(),ios::in|ios::binary);
+  if (!f) return;
+  string buf;
+  f.seekg(0,ios::end);
+  streamoff size = f.tellg();
+  f.seekg(0,ios::beg);
+  if (size > 0) {
+    buf.resize(size);
+    f.read(&buf[0],size);
+    buf.resize(f.gcount());
+  }
+  f.close();
+
+  istringstream s(buf);
+  string::size_type good = 0;		// End of the last complete record
+  for(;;) {
+    string tag;
+    s >> ws >> tag;
+    if (tag != "record") break;
+    ResultCacheRecord rec;
+    Address addr = restoreAddress(s);
+    int4 numranges,numcalls,numglobals,numstrings;
+    int4 textlen;
+    s >> ws >> hex >> rec.confighash >> ws >> rec.inputhash >> ws >> rec.byteshash >> ws >> rec.depshash;
+    s >> ws >> dec >> numranges >> ws >> numcalls >> ws >> numglobals >> ws >> numstrings >> ws >> textlen;
+    if (!s || textlen < 0) break;
+    for(int4 i=0;i<numranges;++i) {
+      Address first = restoreAddress(s);
+      uintb last;
+      s >> ws >> hex >> last;
+      rec.ranges.push_back(Range(first.getSpace(),first.getOffset(),last));
+    }
+    for(int4 i=0;i<numcalls;++i)
+      rec.calls.push_back(restoreAddress(s));
+    for(int4 i=0;i<numglobals;++i)
+      rec.globals.push_back(restoreAddress(s));
+    for(int4 i=0;i<numstrings;++i) {
+      Address straddr = restoreAddress(s);
+      int4 charsize;
+      s >> ws >> dec >> charsize;
+      rec.strings.push_back(pair<Address,int4>(straddr,charsize));
+    }
+    if (s.get() != '\n') break;
+    rec.text.resize(textlen);
+    if (textlen > 0)
+      s.read(&rec.text[0],textlen);
+    if (s.gcount() != textlen && textlen > 0) break;
+    if (s.get() != '\n') break;
+    records[addr] = rec;
+    good = (string::size_type)s.tellg();
+  }
+  if (buf.find_first_not_of(" \t\r\n",good) == string::npos) return;
+  ofstream out(filename.c_str(),ios::out|ios::trunc|ios::binary);
+  if (!out)
+    throw LowlevelError("Unable to write result cache: "+filename);
+  out.write(buf.c_str(),good);
+  out.close();
+}
+
+/// The record is written with a single call at the end of the file, so a reader never
+/// sees a partial record unless the write itself is interrupted.
+/// \param addr is the entry point of the function
+/// \param rec is the record to write
+void ResultCache::append(const Address &addr,const ResultCacheRecord &rec) const
+
+{
+  ostringstream s;
+  s << "record ";
+  saveAddress(s,addr);
+  s << ' ' << hex << rec.confighash << ' ' << rec.inputhash << ' ' << rec.byteshash << ' ' << rec.depshash;
+  s << ' ' << dec << rec.ranges.size() << ' ' << rec.calls.size() << ' ' << rec.globals.size();
+  s << ' ' << rec.strings.size();
+  s << ' ' << rec.text.size() << '\n';
+  for(int4 i=0;i<rec.ranges.size();++i) {
+    saveAddress(s,rec.ranges[i].getFirstAddr());
+    s << ' ' << hex << rec.ranges[i].getLast() << '\n';
+  }
+  for(int4 i=0;i<rec.calls.size();++i) {
+    saveAddress(s,rec.calls[i]);
+    s << '\n';
+  }
+  for(int4 i=0;i<rec.globals.size();++i) {
+    saveAddress(s,rec.globals[i]);
+    s << '\n';
+  }
+  for(int4 i=0;i<rec.strings.size();++i) {
+    saveAddress(s,rec.strings[i].first);
+    s << ' ' << dec << rec.strings[i].second << '\n';
+  }
+  s << rec.text << '\n';
+
+  ofstream f(filename.c_str(),ios::out|ios::app|ios::binary);
+  if (!f)
+    throw LowlevelError("Unable to write result cache: "+filename);
+  string out = s.str();
+  f.write(out.c_str(),out.size());
+  f.close();
+}
+
+/// If the file exists, its records are read immediately.  Otherwise the file is created
+/// when the first record is stored.
+/// \param g is the Architecture whose functions are cached
+/// \param fname is the path of the backing file
+ResultCache::ResultCache(Architecture *g,const string &fname)
+
+{
+  glb = g;
+  filename = fname;
+  resetStatistics();
+  load();
+}
+
+/// The function's inputs are its name, prototype, local scope, overrides, and comments, along with
+/// the full definition of every data-type reachable from them.  This must be called after any
+/// previous analysis of the function has been cleared, so that only the state the decompiler
+/// starts from is hashed.
+/// \param fd is the function
+/// \return the hash of the function's own inputs
+uint8 ResultCache::hashInputs(Funcdata *fd) const
+
+{
+  ostringstream s;
+  vector<Datatype *> types;
+  set<Datatype *> seen;
+  s << fd->getName();
+  fd->getFuncProto().saveXml(s);
+  collectProtoTypes(&fd->getFuncProto(),types,seen);
+
+  ScopeLocal *localscope = fd->getScopeLocal();
+  localscope->saveXml(s);
+  MapIterator iter = localscope->begin();
+  MapIterator enditer = localscope->end();
+  for(;iter!=enditer;++iter)
+    collectType((*iter)->getSymbol()->getType(),types,seen);
+  list<SymbolEntry>::const_iterator diter;
+  for(diter=localscope->beginDynamic();diter!=localscope->endDynamic();++diter)
+    collectType((*diter).getSymbol()->getType(),types,seen);
+
+  const Override &ovr( fd->getOverride() );
+  ovr.saveXml(s,glb);
+  map<Address,FuncProto *>::const_iterator oiter;
+  for(oiter=ovr.getProtoOverrides().begin();oiter!=ovr.getProtoOverrides().end();++oiter)
+    collectProtoTypes((*oiter).second,types,seen);
+
+  CommentSet::const_iterator citer = glb->commentdb->beginComment(fd->getAddress());
+  CommentSet::const_iterator cenditer = glb->commentdb->endComment(fd->getAddress());
+  for(;citer!=cenditer;++citer)
+    (*citer)->saveXml(s);
+  return hashTypes(hashString(0xcbf29ce484222325ULL,s.str()),types);
+}
+
+/// \param fd is the function to look up
+/// \param inputhash is the current value of hashInputs() for the function
+/// \return the cached output, or null if there is no valid record
+const string *ResultCache::lookup(Funcdata *fd,uint8 inputhash)
+
+{
+  bool stale;
+  count_lookup += 1;
+  const ResultCacheRecord *rec = findValid(fd,inputhash,stale);
+  if (rec == (const ResultCacheRecord *)0) {
+    if (stale)
+      count_stale += 1;
+    return (const string *)0;
+  }
+  count_hit += 1;
+  return &rec->text;
+}
+
+/// \param fd is the function to look up
+/// \param inputhash is the current value of hashInputs() for the function
+/// \return the cached output, or null if there is no valid record
+const string *ResultCache::peek(Funcdata *fd,uint8 inputhash) const
+
+{
+  bool stale;
+  const ResultCacheRecord *rec = findValid(fd,inputhash,stale);
+  if (rec == (const ResultCacheRecord *)0)
+    return (const string *)0;
+  return &rec->text;
+}
+
+/// The function must still hold the results of its decompilation, which are used to find the
+/// address ranges and dependencies of the function.  The record is appended to the backing file
+/// and replaces any earlier record for the function.
+/// \param fd is the decompiled function
+/// \param inputhash is the value of hashInputs() taken before decompilation started
+/// \param text is the output to cache
+void ResultCache::store(Funcdata *fd,uint8 inputhash,const string &text)
+
+{
+  ResultCacheRecord rec;
+  rec.confighash = hashConfig();
+  rec.inputhash = inputhash;
+  collectDependencies(fd,rec);
+  rec.byteshash = hashRanges(fd->getAddress(),rec.ranges);
+  rec.depshash = hashDependencies(rec);
+  rec.text = text;
+  append(fd->getAddress(),rec);
+  records[fd->getAddress()] = rec;
+  count_store += 1;
+}
+
+/// \param s is the stream to print to
+void ResultCache::printStatistics(ostream &s) const
+
+{
+  s << "Result cache: " << filename << " records=" << dec << records.size() << endl;
+  s << "  Lookups=" << count_lookup << " Hits=" << count_hit;
+  s << " Stale=" << count_stale << " Stores=" << count_store << endl;
+}
+
+void ResultCache::resetStatistics(void)
+
+{
+  count_lookup = 0;
+  count_hit = 0;
+  count_stale = 0;
+  count_store = 0;
+}
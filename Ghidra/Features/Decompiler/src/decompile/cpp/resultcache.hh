@@ -0,0 +1,99 @@
+/* ###
+ * IP: GHIDRA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/// \file resultcache.hh
+/// \brief A persistent cache of decompiler output, keyed on the inputs to each function
+
+#ifndef __RESULT_CACHE__
+#define __RESULT_CACHE__
+
+#include "address.hh"
+
+class Architecture;
+class Funcdata;
+class Datatype;
+class FuncProto;
+class PcodeOp;
+
+/// \brief The cached output for one function, with hashes of the inputs that produced it
+struct ResultCacheRecord {
+  uint8 confighash;		///< Hash of the root Action, output language, options, memory properties and global ranges
+  uint8 inputhash;		///< Hash of the function's own symbol, prototype, local symbols, overrides, comments and their data-types
+  uint8 byteshash;		///< Hash of the code bytes and context values in \b ranges
+  uint8 depshash;		///< Hash of the symbols and data-types at \b calls and \b globals, and the data at \b strings
+  vector<Range> ranges;		///< Address ranges holding the body of the function
+  vector<Address> calls;	///< Entry points of functions called directly or referenced through a constant pointer
+  vector<Address> globals;	///< Addresses of global variables accessed directly or through a constant pointer
+  vector<pair<Address,int4> > strings;	///< Address and character size of each string literal a constant pointer may print as
+  string text;			///< The cached output
+};
+
+/// \brief A persistent, append-only store of decompiler output
+///
+/// Each record holds the output produced for one function, along with hashes of what it was
+/// produced from:
+///   - the code bytes of the function body, and the context and tracked register values over it
+///   - the function's own symbol, prototype, local symbols, overrides and comments
+///   - the symbols of the functions it calls or takes the address of, and of the global variables
+///     it accesses, whether directly or through a constant pointer
+///   - the data of any string literal a constant pointer in the function may be printed as
+///   - the full definition of every data-type reachable from those symbols and prototypes
+///   - the option configuration, the memory property ranges (\e volatile, \e read-only) and the
+///     address ranges owned by the global scope
+///
+/// A lookup recomputes the hashes against the current state of the Architecture and returns the output
+/// only if all of them match, so a change to one function only invalidates that function and its
+/// direct users.  State that analysis can reach only indirectly, such as a read-only value that is
+/// folded into a constant, is not part of the key.
+///
+/// New records are appended to the backing file, and a later record for a function replaces any
+/// earlier one.  The whole file is read into memory when the cache is opened.
+class ResultCache {
+  Architecture *glb;				///< The Architecture whose functions are cached
+  string filename;				///< Path of the backing file
+  map<Address,ResultCacheRecord> records;	///< The latest record for each function entry point
+  uint4 count_lookup;				///< Number of calls to lookup()
+  uint4 count_hit;				///< Number of lookups returning cached output
+  uint4 count_stale;				///< Number of lookups finding a record whose inputs have changed
+  uint4 count_store;				///< Number of records written
+  static uint8 hashBytes(uint8 h,const uint1 *ptr,int4 size);	///< Fold bytes into a running hash
+  static uint8 hashString(uint8 h,const string &str);	///< Fold a string into a running hash
+  static void collectType(Datatype *ct,vector<Datatype *> &res,set<Datatype *> &seen);	///< Gather a data-type and every data-type it is built from
+  static void collectProtoTypes(const FuncProto *proto,vector<Datatype *> &res,set<Datatype *> &seen);	///< Gather the data-types of a prototype
+  static uint8 hashTypes(uint8 h,const vector<Datatype *> &types);	///< Fold full data-type definitions into a running hash
+  uint8 hashConfig(void) const;			///< Hash the current option configuration and memory properties
+  uint8 hashRanges(const Address &entry,const vector<Range> &ranges) const;	///< Hash the code bytes and context in the given ranges
+  uint8 hashDependencies(const ResultCacheRecord &rec) const;	///< Hash the symbols and string data a record depends on
+  void collectConstant(const PcodeOp *op,int4 slot,set<Address> &calls,set<Address> &globals,
+		       set<pair<Address,int4> > &strings) const;	///< Record what a constant may be printed as
+  void collectDependencies(Funcdata *fd,ResultCacheRecord &rec) const;	///< Record the ranges and dependencies of a decompiled function
+  const ResultCacheRecord *findValid(Funcdata *fd,uint8 inputhash,bool &stale) const;	///< Find a record whose inputs still match
+  void saveAddress(ostream &s,const Address &addr) const;	///< Write an address to the backing file
+  Address restoreAddress(istream &s) const;	///< Read an address from the backing file
+  void load(void);				///< Read all records from the backing file
+  void append(const Address &addr,const ResultCacheRecord &rec) const;	///< Write a record to the end of the backing file
+public:
+  ResultCache(Architecture *g,const string &fname);	///< Open the cache backed by the given file
+  const string &getFilename(void) const { return filename; }	///< Get the path of the backing file
+  int4 numRecords(void) const { return records.size(); }	///< Get the number of functions with a record
+  uint8 hashInputs(Funcdata *fd) const;		///< Hash the inputs belonging to the function itself
+  const string *lookup(Funcdata *fd,uint8 inputhash);	///< Look up valid output for the given function
+  const string *peek(Funcdata *fd,uint8 inputhash) const;	///< Look up valid output without updating statistics
+  void store(Funcdata *fd,uint8 inputhash,const string &text);	///< Save output for a freshly decompiled function
+  void printStatistics(ostream &s) const;	///< Print lookup statistics for \b this cache
+  void resetStatistics(void);			///< Reset the lookup statistics to zero
+};
+
+#endif
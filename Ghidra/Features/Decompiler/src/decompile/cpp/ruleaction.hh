@@ -204,7 +204,7 @@ public:
 };
 class RuleShiftBitops : public Rule {
 public:
-  RuleShiftBitops(const string &g) : Rule(g, 0, "shiftbitops") {}	///< Constructor
+  RuleShiftBitops(const string &g) : Rule(g, 0, "shiftbitops") { setFilter(in1_constant|in0_written); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleShiftBitops(getGroup());
@@ -214,7 +214,7 @@ public:
 };
 class RuleRightShiftAnd : public Rule {
 public:
-  RuleRightShiftAnd(const string &g) : Rule(g, 0, "rightshiftand") {}	///< Constructor
+  RuleRightShiftAnd(const string &g) : Rule(g, 0, "rightshiftand") { setFilter(in1_constant|in0_written,CPUI_INT_AND); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleRightShiftAnd(getGroup());
@@ -321,7 +321,7 @@ public:
 };
 class RuleLessOne : public Rule {
 public:
-  RuleLessOne(const string &g) : Rule(g, 0, "lessone") {}	///< Constructor
+  RuleLessOne(const string &g) : Rule(g, 0, "lessone") { setFilter(in1_constant); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleLessOne(getGroup());
@@ -371,7 +371,7 @@ public:
 };  
 class RuleAndCompare : public Rule {
 public:
-  RuleAndCompare(const string &g) : Rule(g, 0, "andcompare") {}	///< Constructor
+  RuleAndCompare(const string &g) : Rule(g, 0, "andcompare") { setFilter(in1_constant); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleAndCompare(getGroup());
@@ -401,7 +401,7 @@ public:
 };
 class RuleDoubleArithShift : public Rule {
 public:
-  RuleDoubleArithShift(const string &g) : Rule(g, 0, "doublearithshift") {}	///< Constructor
+  RuleDoubleArithShift(const string &g) : Rule(g, 0, "doublearithshift") { setFilter(in1_constant|in0_written,CPUI_INT_SRIGHT); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleDoubleArithShift(getGroup());
@@ -411,7 +411,7 @@ public:
 };
 class RuleConcatShift : public Rule {
 public:
-  RuleConcatShift(const string &g) : Rule(g, 0, "concatshift") {}	///< Constructor
+  RuleConcatShift(const string &g) : Rule(g, 0, "concatshift") { setFilter(in1_constant|in0_written,CPUI_PIECE); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleConcatShift(getGroup());
@@ -421,7 +421,7 @@ public:
 };
 class RuleLeftRight : public Rule {
 public:
-  RuleLeftRight(const string &g) : Rule(g, 0, "leftright") {}	///< Constructor
+  RuleLeftRight(const string &g) : Rule(g, 0, "leftright") { setFilter(in1_constant|in0_written,CPUI_INT_LEFT); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleLeftRight(getGroup());
@@ -551,7 +551,7 @@ public:
 };
 class RuleLogic2Bool : public Rule {
 public:
-  RuleLogic2Bool(const string &g) : Rule(g, 0, "logic2bool") {}	///< Constructor
+  RuleLogic2Bool(const string &g) : Rule(g, 0, "logic2bool") { setFilter(in0_written); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleLogic2Bool(getGroup());
@@ -712,7 +712,7 @@ public:
 };
 class RuleXorCollapse : public Rule {
 public:
-  RuleXorCollapse(const string &g) : Rule(g, 0, "xorcollapse") {}	///< Constructor
+  RuleXorCollapse(const string &g) : Rule(g, 0, "xorcollapse") { setFilter(in1_constant|in0_written,CPUI_INT_XOR); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleXorCollapse(getGroup());
@@ -827,7 +827,7 @@ public:
 };
 class RuleZextCommute : public Rule {
 public:
-  RuleZextCommute(const string &g) : Rule(g, 0, "zextcommute") {}	///< Constructor
+  RuleZextCommute(const string &g) : Rule(g, 0, "zextcommute") { setFilter(in0_written,CPUI_INT_ZEXT); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleZextCommute(getGroup());
@@ -837,7 +837,7 @@ public:
 };
 class RuleZextShiftZext : public Rule {
 public:
-  RuleZextShiftZext(const string &g) : Rule(g, 0, "zextshiftzext") {}	///< Constructor
+  RuleZextShiftZext(const string &g) : Rule(g, 0, "zextshiftzext") { setFilter(in0_written); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleZextShiftZext(getGroup());
@@ -847,7 +847,7 @@ public:
 };
 class RuleShiftAnd : public Rule {
 public:
-  RuleShiftAnd(const string &g) : Rule(g, 0, "shiftand") {}	///< Constructor
+  RuleShiftAnd(const string &g) : Rule(g, 0, "shiftand") { setFilter(in1_constant|in0_written,CPUI_INT_AND); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleShiftAnd(getGroup());
@@ -857,7 +857,7 @@ public:
 };
 class RuleConcatZero : public Rule {
 public:
-  RuleConcatZero(const string &g) : Rule(g, 0, "concatzero") {}	///< Constructor
+  RuleConcatZero(const string &g) : Rule(g, 0, "concatzero") { setFilter(in1_constant); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleConcatZero(getGroup());
@@ -867,7 +867,7 @@ public:
 };
 class RuleConcatLeftShift : public Rule {
 public:
-  RuleConcatLeftShift(const string &g) : Rule(g, 0, "concatleftshift") {}	///< Constructor
+  RuleConcatLeftShift(const string &g) : Rule(g, 0, "concatleftshift") { setFilter(in1_written); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleConcatLeftShift(getGroup());
@@ -897,7 +897,7 @@ public:
 };
 class RuleShiftSub : public Rule {
 public:
-  RuleShiftSub(const string &g) : Rule(g, 0, "shiftsub") {}	///< Constructor
+  RuleShiftSub(const string &g) : Rule(g, 0, "shiftsub") { setFilter(in0_written,CPUI_INT_LEFT); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleShiftSub(getGroup());
@@ -1018,7 +1018,7 @@ public:
 };
 class RuleEqual2Constant : public Rule {
 public:
-  RuleEqual2Constant(const string &g) : Rule(g, 0, "equal2constant") {}	///< Constructor
+  RuleEqual2Constant(const string &g) : Rule(g, 0, "equal2constant") { setFilter(in1_constant|in0_written); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleEqual2Constant(getGroup());
@@ -1092,7 +1092,7 @@ public:
 
 class RuleAddUnsigned : public Rule {
 public:
-  RuleAddUnsigned(const string &g) : Rule( g, 0, "addunsigned") {}	///< Constructor
+  RuleAddUnsigned(const string &g) : Rule( g, 0, "addunsigned") { setFilter(in1_constant); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleAddUnsigned(getGroup());
@@ -1137,7 +1137,7 @@ public:
 
 class RuleSubNormal : public Rule {
 public:
-  RuleSubNormal(const string &g) : Rule( g, 0, "subnormal") {}	///< Constructor
+  RuleSubNormal(const string &g) : Rule( g, 0, "subnormal") { setFilter(in0_written); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleSubNormal(getGroup());
@@ -1182,7 +1182,7 @@ public:
 
 class RuleDivTermAdd2 : public Rule {
 public:
-  RuleDivTermAdd2(const string &g) : Rule( g, 0, "divtermadd2") {}	///< Constructor
+  RuleDivTermAdd2(const string &g) : Rule( g, 0, "divtermadd2") { setFilter(in1_constant|in0_written,CPUI_INT_ADD); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleDivTermAdd2(getGroup());
@@ -1230,7 +1230,7 @@ public:
 
 class RuleSignNearMult : public Rule {
 public:
-  RuleSignNearMult(const string &g) : Rule( g, 0, "signnearmult") {}	///< Constructor
+  RuleSignNearMult(const string &g) : Rule( g, 0, "signnearmult") { setFilter(in1_constant|in0_written,CPUI_INT_ADD); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleSignNearMult(getGroup());
@@ -1263,7 +1263,7 @@ public:
 
 class RuleSubvarAnd : public Rule {
 public:
-  RuleSubvarAnd(const string &g) : Rule( g, 0, "subvar_and") {}	///< Constructor
+  RuleSubvarAnd(const string &g) : Rule( g, 0, "subvar_and") { setFilter(in1_constant); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleSubvarAnd(getGroup());
@@ -1313,7 +1313,7 @@ public:
 
 class RuleSubvarCompZero : public Rule {
 public:
-  RuleSubvarCompZero(const string &g) : Rule( g, 0, "subvar_compzero") {}	///< Constructor
+  RuleSubvarCompZero(const string &g) : Rule( g, 0, "subvar_compzero") { setFilter(in1_constant); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleSubvarCompZero(getGroup());
@@ -1370,7 +1370,7 @@ public:
 
 class RuleNegateNegate : public Rule {
 public:
-  RuleNegateNegate(const string &g) : Rule( g, 0, "negatenegate") {}	///< Constructor
+  RuleNegateNegate(const string &g) : Rule( g, 0, "negatenegate") { setFilter(in0_written,CPUI_INT_NEGATE); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleNegateNegate(getGroup());
@@ -1409,7 +1409,7 @@ public:
 
 class RuleFloatCast : public Rule {
 public:
-  RuleFloatCast(const string &g) : Rule( g, 0, "floatcast") {}	///< Constructor
+  RuleFloatCast(const string &g) : Rule( g, 0, "floatcast") { setFilter(in0_written); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RuleFloatCast(getGroup());
@@ -1469,7 +1469,7 @@ class RulePiecePathology : public Rule {
   static bool isPathology(Varnode *vn,Funcdata &data);
   static int4 tracePathologyForward(PcodeOp *op,Funcdata &data);
 public:
-  RulePiecePathology(const string &g) : Rule( g, 0, "piecepathology") {}	///< Constructor
+  RulePiecePathology(const string &g) : Rule( g, 0, "piecepathology") { setFilter(in0_written); }	///< Constructor
   virtual Rule *clone(const ActionGroupList &grouplist) const {
     if (!grouplist.contains(getGroup())) return (Rule *)0;
     return new RulePiecePathology(getGroup());
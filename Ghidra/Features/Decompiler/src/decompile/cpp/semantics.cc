@@ -381,20 +381,14 @@ void ConstTpl::restoreXml(const Element *el,const AddrSpaceManager *manage)
   const string &typestring(el->getAttributeValue("type"));
   if (typestring == "real") {
     type = real;
-    istringstream s(el->getAttributeValue("val"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> value_real;
+    value_real = xml_readnumber(el->getAttributeValue("val"));
   }
   else if (typestring=="handle") {
     type = handle;
-    istringstream s(el->getAttributeValue("val"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> value.handle_index;
+    value.handle_index = xml_readnumber(el->getAttributeValue("val"));
     select = readHandleSelector(el->getAttributeValue("s"));
     if (select == v_offset_plus) {
-      istringstream s2(el->getAttributeValue("plus"));
-      s2.unsetf(ios::dec | ios::hex | ios::oct);
-      s2 >> value_real;
+      value_real = xml_readnumber(el->getAttributeValue("plus"));
     }
   }
   else if (typestring=="start") {
@@ -415,9 +409,7 @@ void ConstTpl::restoreXml(const Element *el,const AddrSpaceManager *manage)
   }
   else if (typestring=="relative") {
     type = j_relative;
-    istringstream s(el->getAttributeValue("val"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> value_real;
+    value_real = xml_readnumber(el->getAttributeValue("val"));
   }
   else if (typestring == "flowref") {
     type = j_flowref;
@@ -897,19 +889,13 @@ int4 ConstructTpl::restoreXml(const Element *el,const AddrSpaceManager *manage)
   int4 sectionid = -1;
   for(int4 i=0;i<el->getNumAttributes();++i) {
     if (el->getAttributeName(i)=="delay") {
-      istringstream s(el->getAttributeValue(i));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> delayslot;
+      delayslot = xml_readnumber(el->getAttributeValue(i));
     }
     else if (el->getAttributeName(i)=="labels") {
-      istringstream s(el->getAttributeValue(i));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> numlabels;
+      numlabels = xml_readnumber(el->getAttributeValue(i));
     }
     else if (el->getAttributeName(i)=="section") {
-      istringstream s(el->getAttributeValue(i));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> sectionid;
+      sectionid = xml_readnumber(el->getAttributeValue(i));
     }
   }
   const List &list(el->getChildren());
@@ -0,0 +1,171 @@
+/* ###
+ * IP: GHIDRA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/// \file slabpool.hh
+/// \brief Pools for allocating many objects of a single size
+#ifndef __SLABPOOL__
+#define __SLABPOOL__
+
+#include "types.h"
+#include <new>
+#include <vector>
+
+using namespace std;
+
+/// \brief A pool of fixed size memory slots
+///
+/// Memory is requested from the system in large \e slabs, each holding many slots,
+/// and handed out one slot at a time.  A slot that is given back with recycle() is put
+/// on a free list and is reused by the next allocation. All slabs are returned to the
+/// system at once by release().
+///
+/// The pool only manages raw memory: the owner constructs objects with placement \b new
+/// and must run their destructors before recycling a slot or releasing the pool.
+class SlabPoolBase {
+  /// \brief Overlay for a slot that is on the free list
+  struct FreeSlot {
+    FreeSlot *next;		///< Next slot on the free list
+  };
+  vector<char *> slabs;		///< All slabs allocated from the system
+  FreeSlot *freelist;		///< Slots that have been recycled
+  char *cur;			///< Next never-used slot in the current slab
+  char *end;			///< End of the current slab
+  int4 slotSize;		///< Number of bytes in a single slot
+  int4 slotsPerSlab;		///< Number of slots in each slab
+  static int4 roundSize(int4 sz) {
+    if (sz < sizeof(FreeSlot)) sz = sizeof(FreeSlot);
+    return (sz + 7) & ~7;	// Keep each slot 8-byte aligned
+  }				///< Get the slot size needed to hold an object of the given size
+  SlabPoolBase(const SlabPoolBase &op2);		///< Pools are not copyable
+  SlabPoolBase &operator=(const SlabPoolBase &op2);	///< Pools are not assignable
+public:
+  SlabPoolBase(int4 sz,int4 num);	///< Constructor
+  ~SlabPoolBase(void) { release(); }	///< Destructor
+  bool fitSlot(int4 sz) const { return (sz <= slotSize); }	///< Check if an object of the given size can be allocated from \b this
+  void *allocate(void);		///< Get memory for one object
+  void recycle(void *ptr);	///< Give back the memory of one (destroyed) object
+  void release(void);		///< Give back all memory in the pool to the system
+
+  /// \brief Get the slot size needed for the nodes of a set or map
+  ///
+  /// Red-black tree nodes in the common STL implementations hold three links and a color
+  /// ahead of the value.  Nodes from an implementation with a bigger layout do not fit
+  /// and go to the heap.
+  /// \param valsize is the size of the value held by each node
+  /// \return the number of bytes in a node
+  static int4 treeNodeSize(int4 valsize) { return 4*sizeof(void *) + valsize; }
+};
+
+/// \brief A pool of memory slots for objects of a single type
+template<typename _type>
+class SlabPool : public SlabPoolBase {
+public:
+  SlabPool(int4 num=256) : SlabPoolBase(sizeof(_type),num) {}	///< Constructor
+};
+
+/// \brief An STL allocator drawing single objects from a SlabPoolBase
+///
+/// This lets a node based container (set, map, list) keep its nodes in a pool owned by
+/// some other object, so that node memory is contiguous and an erase followed by an insert
+/// reuses the same node.  Requests for more than one object, or for objects too big for
+/// the pool's slots, go to the normal heap.  A default constructed allocator has no pool
+/// and always uses the heap.
+///
+/// A container may also draw its own bookkeeping (a sentinel node, a debug proxy) from the
+/// allocator, so the pool must outlive every container using it, and must not be released
+/// while any of them still exists.
+template<typename _type>
+class SlabAllocator {
+  template<typename _other> friend class SlabAllocator;
+  SlabPoolBase *pool;		///< The underlying pool (may be null)
+public:
+  typedef _type value_type;	///< Type of object being allocated
+  SlabAllocator(void) { pool = (SlabPoolBase *)0; }	///< Construct allocator that uses the heap
+  SlabAllocator(SlabPoolBase *p) { pool = p; }		///< Construct allocator on a specific pool
+  template<typename _other>
+  SlabAllocator(const SlabAllocator<_other> &op2) { pool = op2.pool; }	///< Copy from allocator of another type
+  _type *allocate(size_t n) {
+    if (n == 1 && pool != (SlabPoolBase *)0 && pool->fitSlot(sizeof(_type)))
+      return (_type *)pool->allocate();
+    return (_type *)::operator new(n * sizeof(_type));
+  }				///< Allocate memory for \b n objects
+  void deallocate(_type *ptr,size_t n) {
+    if (n == 1 && pool != (SlabPoolBase *)0 && pool->fitSlot(sizeof(_type)))
+      pool->recycle(ptr);
+    else
+      ::operator delete(ptr);
+  }				///< Free memory for \b n objects
+  template<typename _other>
+  bool operator==(const SlabAllocator<_other> &op2) const { return (pool == op2.pool); }	///< Compare allocators
+  template<typename _other>
+  bool operator!=(const SlabAllocator<_other> &op2) const { return (pool != op2.pool); }	///< Compare allocators
+};
+
+/// \param sz is the size of objects in bytes
+/// \param num is the number of objects in each slab
+inline SlabPoolBase::SlabPoolBase(int4 sz,int4 num)
+
+{
+  freelist = (FreeSlot *)0;
+  cur = (char *)0;
+  end = (char *)0;
+  slotSize = roundSize(sz);
+  slotsPerSlab = num;
+}
+
+/// The slot is taken from the free list if possible, otherwise from the current slab.
+/// A new slab is allocated when the current one is exhausted.
+/// \return uninitialized memory for one object
+inline void *SlabPoolBase::allocate(void)
+
+{
+  if (freelist != (FreeSlot *)0) {
+    FreeSlot *res = freelist;
+    freelist = res->next;
+    return res;
+  }
+  if (cur == end) {
+    cur = (char *)::operator new(slotSize * slotsPerSlab);
+    slabs.push_back(cur);
+    end = cur + slotSize * slotsPerSlab;
+  }
+  void *res = cur;
+  cur += slotSize;
+  return res;
+}
+
+/// The object occupying the slot must already have been destroyed.
+/// \param ptr is the slot, as returned by allocate()
+inline void SlabPoolBase::recycle(void *ptr)
+
+{
+  FreeSlot *slot = (FreeSlot *)ptr;
+  slot->next = freelist;
+  freelist = slot;
+}
+
+/// All objects allocated from the pool must already have been destroyed.
+inline void SlabPoolBase::release(void)
+
+{
+  for(int4 i=0;i<slabs.size();++i)
+    ::operator delete(slabs[i]);
+  slabs.clear();
+  freelist = (FreeSlot *)0;
+  cur = (char *)0;
+  end = (char *)0;
+}
+
+#endif
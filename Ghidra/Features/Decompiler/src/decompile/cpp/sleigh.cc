@@ -360,17 +360,25 @@ void DisassemblyCache::initialize(int4 min,int4 hashsize)
   uintb masktest = coveringmask((uintb)mask);
   if (masktest != (uintb)mask)	// -hashsize- must be a power of 2
     throw LowlevelError("Bad windowsize for disassembly cache");
+  if (minimumreuse < 1)
+    throw LowlevelError("Bad cachesize for disassembly cache");
   list = new ParserContext *[minimumreuse];
-  nextfree = 0;
-  hashtable = new ParserContext *[hashsize];
+  prev = new int4[minimumreuse];
+  next = new int4[minimumreuse];
+  hashtable = new int4[hashsize];
   for(int4 i=0;i<minimumreuse;++i) {
     ParserContext *pos = new ParserContext(contextcache);
     pos->initialize(75,20,constspace);
     list[i] = pos;
+    prev[i] = i-1;		// Initial LRU order is the order of the array
+    next[i] = i+1;
   }
-  ParserContext *pos = list[0];
+  next[minimumreuse-1] = -1;
+  head = 0;
+  tail = minimumreuse-1;
   for(int4 i=0;i<hashsize;++i)
-    hashtable[i] = pos;		// Make sure all hashtable positions point to a real ParserContext
+    hashtable[i] = 0;		// Make sure all hashtable positions point to a real ParserContext
+  resetStatistics();
 }
 
 void DisassemblyCache::free(void)
@@ -379,9 +387,26 @@ void DisassemblyCache::free(void)
   for(int4 i=0;i<minimumreuse;++i)
     delete list[i];
   delete [] list;
+  delete [] prev;
+  delete [] next;
   delete [] hashtable;
 }
 
+void DisassemblyCache::moveToFront(int4 slot)
+
+{ // Make -slot- the most recently used
+  if (slot == head) return;
+  next[prev[slot]] = next[slot];	// Unlink from current position
+  if (slot == tail)
+    tail = prev[slot];
+  else
+    prev[next[slot]] = prev[slot];
+  prev[slot] = -1;
+  next[slot] = head;
+  prev[head] = slot;
+  head = slot;
+}
+
 DisassemblyCache::DisassemblyCache(ContextCache *ccache,AddrSpace *cspace,int4 cachesize,int4 windowsize)
 
 {
@@ -397,20 +422,44 @@ ParserContext *DisassemblyCache::getParserContext(const Address &addr)
   //    n <= minimumreuse   AND
   //    all the addresses are within the windowsize (=mask+1)
   // then the cacher guarantees that you get all different ParserContext objects
+  // Slots are reused in least recently used order, so frequently revisited instructions stay parsed
+  count_lookup += 1;
   int4 hashindex = ((int4) addr.getOffset()) & mask;
-  ParserContext *res = hashtable[ hashindex ];
-  if (res->getAddr() == addr)
+  int4 slot = hashtable[ hashindex ];
+  ParserContext *res = list[ slot ];
+  if (res->getAddr() == addr) {
+    count_hit += 1;
+    moveToFront(slot);
     return res;
-  res = list[ nextfree ];
-  nextfree += 1;		// Advance the circular index
-  if (nextfree >= minimumreuse)
-    nextfree = 0;
+  }
+  slot = tail;			// Reuse the least recently used slot
+  moveToFront(slot);
+  res = list[ slot ];
+  if (res->getParserState() != ParserContext::uninitialized)
+    count_evict += 1;
   res->setAddr(addr);
   res->setParserState(ParserContext::uninitialized);	// Need to start over with parsing
-  hashtable[ hashindex ] = res;	// Stick it into the hashtable
+  hashtable[ hashindex ] = slot;	// Stick it into the hashtable
   return res;
 }
 
+void DisassemblyCache::printStatistics(ostream &s) const
+
+{
+  s << "Parser cache: size=" << dec << minimumreuse << " window=" << (mask+1) << endl;
+  s << "  Lookups=" << count_lookup << " Hits=" << count_hit;
+  s << " Evictions=" << count_evict << " Resolves=" << count_resolve << endl;
+}
+
+void DisassemblyCache::resetStatistics(void)
+
+{
+  count_lookup = 0;
+  count_hit = 0;
+  count_evict = 0;
+  count_resolve = 0;
+}
+
 Sleigh::Sleigh(LoadImage *ld,ContextDatabase *c_db)
   : SleighBase()
 
@@ -419,6 +468,8 @@ Sleigh::Sleigh(LoadImage *ld,ContextDatabase *c_db)
   context_db = c_db;
   cache = new ContextCache(c_db);
   discache = (DisassemblyCache *)0;
+  parser_cachesize = 0;
+  parser_windowsize = 0;
 }
 
 void Sleigh::clearForDelete(void)
@@ -458,24 +509,35 @@ void Sleigh::initialize(DocumentStorage &store)
   }
   else
     reregisterContext();
-  uint4 parser_cachesize = 2;
-  uint4 parser_windowsize = 32;
+  discache = newDisassemblyCache(cache);
+}
+
+DisassemblyCache *Sleigh::newDisassemblyCache(ContextCache *ccache) const
+
+{ // Build a ParserContext pool sized for this specification, or as requested by setParserCacheSize
+  int4 cachesize = 2;
+  int4 windowsize = 32;
   if ((maxdelayslotbytes > 1)||(unique_allocatemask != 0)) {
-    parser_cachesize = 8;
-    parser_windowsize = 256;
+    cachesize = 8;
+    windowsize = 256;
   }
-  discache = new DisassemblyCache(cache,getConstantSpace(),parser_cachesize,parser_windowsize);
+  if (parser_cachesize > cachesize)	// Never go below what the specification needs
+    cachesize = parser_cachesize;
+  if (parser_windowsize != 0)
+    windowsize = parser_windowsize;
+  return new DisassemblyCache(ccache,getConstantSpace(),cachesize,windowsize);
 }
 
-ParserContext *Sleigh::obtainContext(const Address &addr,int4 state) const
+ParserContext *Sleigh::obtainContext(DisassemblyCache *dcache,const Address &addr,int4 state) const
 
-{ // Obtain a ParserContext for the instruction at the given -addr-.  This may be cached.
+{ // Obtain a ParserContext for the instruction at the given -addr- from -dcache-.  This may be cached.
   // Make sure parsing has proceeded to at least the given -state.
-  ParserContext *pos = discache->getParserContext(addr);
+  ParserContext *pos = dcache->getParserContext(addr);
   int4 curstate = pos->getParserState();
   if (curstate >= state)
     return pos;
   if (curstate == ParserContext::uninitialized) {
+    dcache->countResolve();
     resolve(*pos);
     if (state == ParserContext::disassembly)
       return pos;
@@ -618,6 +680,12 @@ int4 Sleigh::printAssembly(AssemblyEmit &emit,const Address &baseaddr) const
 int4 Sleigh::oneInstruction(PcodeEmit &emit,const Address &baseaddr) const
 
 {
+  return buildInstruction(emit,baseaddr,discache,pcode_cache);
+}
+
+int4 Sleigh::buildInstruction(PcodeEmit &emit,const Address &baseaddr,DisassemblyCache *dcache,PcodeCacher &pcache) const
+
+{ // Generate p-code for one instruction, using the given parsing state
   int4 fallOffset;
   if (alignment != 1) {
     if ((baseaddr.getOffset() % alignment)!=0) {
@@ -627,7 +695,7 @@ int4 Sleigh::oneInstruction(PcodeEmit &emit,const Address &baseaddr) const
     }
   }
   
-  ParserContext *pos = obtainContext(baseaddr,ParserContext::pcode);
+  ParserContext *pos = obtainContext(dcache,baseaddr,ParserContext::pcode);
   pos->applyCommits();
   fallOffset = pos->getLength();
   
@@ -635,7 +703,7 @@ int4 Sleigh::oneInstruction(PcodeEmit &emit,const Address &baseaddr) const
     int4 bytecount = 0;
     do {
     // Do not pass pos->getNaddr() to obtainContext, as pos may have been previously cached and had naddr adjusted
-      ParserContext *delaypos = obtainContext(pos->getAddr() + fallOffset,ParserContext::pcode);
+      ParserContext *delaypos = obtainContext(dcache,pos->getAddr() + fallOffset,ParserContext::pcode);
       delaypos->applyCommits();
       int4 len = delaypos->getLength();
       fallOffset += len;
@@ -645,12 +713,12 @@ int4 Sleigh::oneInstruction(PcodeEmit &emit,const Address &baseaddr) const
   }
   ParserWalker walker(pos);
   walker.baseState();
-  pcode_cache.clear();
-  SleighBuilder builder(&walker,discache,&pcode_cache,getConstantSpace(),getUniqueSpace(),unique_allocatemask);
+  pcache.clear();
+  SleighBuilder builder(&walker,dcache,&pcache,getConstantSpace(),getUniqueSpace(),unique_allocatemask);
   try {
     builder.build(walker.getConstructor()->getTempl(),-1);
-    pcode_cache.resolveRelatives();
-    pcode_cache.emit(baseaddr,&emit);
+    pcache.resolveRelatives();
+    pcache.emit(baseaddr,&emit);
   } catch(UnimplError &err) {
     ostringstream s;
     s << "Instruction not implemented in pcode:\n ";
@@ -686,3 +754,95 @@ void Sleigh::allowContextSet(bool val) const
 {
   cache->allowSet(val);
 }
+
+void Sleigh::setParserCacheSize(int4 cachesize,int4 windowsize) const
+
+{ // Record the requested size and rebuild the cache if it already exists
+  if (windowsize != 0) {
+    uintb masktest = coveringmask((uintb)(windowsize-1));
+    if ((windowsize < 0)||(masktest != (uintb)(windowsize-1)))
+      throw LowlevelError("Parser cache window size must be a power of 2");
+  }
+  if (cachesize < 0)
+    throw LowlevelError("Bad parser cache size");
+  parser_cachesize = cachesize;
+  parser_windowsize = windowsize;
+  if (discache != (DisassemblyCache *)0) {
+    delete discache;
+    discache = newDisassemblyCache(cache);
+  }
+}
+
+void Sleigh::printParserCacheStatistics(ostream &s) const
+
+{
+  if (discache != (DisassemblyCache *)0)
+    discache->printStatistics(s);
+  cache->printStatistics(s);
+}
+
+void Sleigh::resetParserCacheStatistics(void) const
+
+{
+  if (discache != (DisassemblyCache *)0)
+    discache->resetStatistics();
+  cache->resetStatistics();
+}
+
+/// The translator must already be initialized.
+/// \param sl is the translator whose specification is shared
+SleighLifter::SleighLifter(const Sleigh *sl)
+
+{
+  sleigh = sl;
+  cache = new ContextCache(sl->context_db);
+  discache = sl->newDisassemblyCache(cache);
+}
+
+SleighLifter::~SleighLifter(void)
+
+{
+  delete discache;
+  delete cache;
+}
+
+/// \param baseaddr is the address of the instruction
+/// \return the length of the instruction in bytes
+int4 SleighLifter::instructionLength(const Address &baseaddr) const
+
+{
+  ParserContext *pos = sleigh->obtainContext(discache,baseaddr,ParserContext::disassembly);
+  return pos->getLength();
+}
+
+/// This produces the same p-code as Sleigh::oneInstruction(), but only this lifter's
+/// parsing state is modified.
+/// \param emit is the p-code emitter receiving the operations
+/// \param baseaddr is the address of the instruction
+/// \return the length of the instruction in bytes, including any delay slots
+int4 SleighLifter::oneInstruction(PcodeEmit &emit,const Address &baseaddr)
+
+{
+  return sleigh->buildInstruction(emit,baseaddr,discache,pcode_cache);
+}
+
+/// Instructions are decoded one after the other, each starting where the previous one
+/// (including its delay slots) ended, and their p-code is emitted in address order.
+/// Lifting stops at the first instruction starting at or after \b end.  Any error decoding an
+/// instruction is passed back to the caller, who can restart after the bad address.
+/// \param emit is the p-code emitter receiving the operations
+/// \param start is the address of the first instruction
+/// \param end is the address bounding the range
+/// \return the address just past the last instruction lifted
+Address SleighLifter::liftRange(PcodeEmit &emit,const Address &start,const Address &end)
+
+{
+  Address addr = start;
+  while(addr < end) {
+    int4 length = oneInstruction(emit,addr);
+    Address next = addr + length;
+    if (next < addr) return next;	// Wrapped around the end of the space
+    addr = next;
+  }
+  return addr;
+}
@@ -71,15 +71,28 @@ class DisassemblyCache {
   AddrSpace *constspace;
   int4 minimumreuse;		// Can call getParserContext this many times, before a ParserContext is reused
   uint4 mask;			// Size of the hashtable in form 2^n-1
-  ParserContext **list;		// (circular) array of currently cached ParserContext objects
-  int4 nextfree;		// Current end/beginning of circular list
-  ParserContext **hashtable;	// Hashtable for looking up ParserContext via Address
+  ParserContext **list;		// Array of currently cached ParserContext objects
+  int4 *prev;			// Previous (more recently used) slot in the LRU order, or -1
+  int4 *next;			// Next (less recently used) slot in the LRU order, or -1
+  int4 head;			// Most recently used slot
+  int4 tail;			// Least recently used slot, the next one to be reused
+  int4 *hashtable;		// Hashtable for looking up a slot via Address
+  uint4 count_lookup;		// Number of calls to getParserContext
+  uint4 count_hit;		// Number of lookups that found a cached ParserContext
+  uint4 count_evict;		// Number of parsed instructions thrown out to make room
+  uint4 count_resolve;		// Number of instructions parsed
   void initialize(int4 min,int4 hashsize);
   void free(void);
+  void moveToFront(int4 slot);
 public:
   DisassemblyCache(ContextCache *ccache,AddrSpace *cspace,int4 cachesize,int4 windowsize);
   ~DisassemblyCache(void) { free(); }
   ParserContext *getParserContext(const Address &addr);
+  void countResolve(void) { count_resolve += 1; }	// Note that a ParserContext had to be (re)parsed
+  int4 getCacheSize(void) const { return minimumreuse; }
+  int4 getWindowSize(void) const { return mask+1; }
+  void printStatistics(ostream &s) const;
+  void resetStatistics(void);
 };
 
 class SleighBuilder : public PcodeBuilder {
@@ -103,14 +116,20 @@ public:
 };
 
 class Sleigh : public SleighBase {
+  friend class SleighLifter;
   LoadImage *loader;
   ContextDatabase *context_db;
   ContextCache *cache;
   mutable DisassemblyCache *discache;
   mutable PcodeCacher pcode_cache;
+  mutable int4 parser_cachesize;	// Requested number of cached ParserContexts (0 for the default)
+  mutable int4 parser_windowsize;	// Requested size of the ParserContext hashtable (0 for the default)
   void clearForDelete(void);
+  DisassemblyCache *newDisassemblyCache(ContextCache *ccache) const;
+  ParserContext *obtainContext(DisassemblyCache *dcache,const Address &addr,int4 state) const;
+  int4 buildInstruction(PcodeEmit &emit,const Address &baseaddr,DisassemblyCache *dcache,PcodeCacher &pcache) const;
 protected:
-  ParserContext *obtainContext(const Address &addr,int4 state) const;
+  ParserContext *obtainContext(const Address &addr,int4 state) const { return obtainContext(discache,addr,state); }
   void resolve(ParserContext &pos) const;
   void resolveHandles(ParserContext &pos) const;
 public:
@@ -121,11 +140,40 @@ public:
   virtual void registerContext(const string &name,int4 sbit,int4 ebit);
   virtual void setContextDefault(const string &nm,uintm val);
   virtual void allowContextSet(bool val) const;
+  virtual void setParserCacheSize(int4 cachesize,int4 windowsize) const;
+  virtual void printParserCacheStatistics(ostream &s) const;
+  virtual void resetParserCacheStatistics(void) const;
   virtual int4 instructionLength(const Address &baseaddr) const;
   virtual int4 oneInstruction(PcodeEmit &emit,const Address &baseaddr) const;
   virtual int4 printAssembly(AssemblyEmit &emit,const Address &baseaddr) const;
 };
 
+/// \brief Generate p-code from a Sleigh translator's specification, using private parsing state
+///
+/// A Sleigh object keeps its ParserContext pool, PcodeCacher, and ContextCache internally, so only
+/// one stream of instructions can be lifted through it at a time.  A SleighLifter shares the
+/// translator's loaded specification (symbol table, decision trees, and constructor templates), which
+/// is never modified after initialization, but owns its own copy of all the state that changes while
+/// parsing.  Separate lifters over the same translator can therefore work on different parts of an image,
+/// even on different threads, as long as:
+///   - the LoadImage can service concurrent loadFill() calls
+///   - no lifter writes to the shared ContextDatabase (see allowContextSet())
+///
+/// The Sleigh object must be initialized before a lifter is built on it, and it must outlive the lifter.
+class SleighLifter {
+  const Sleigh *sleigh;			///< Translator providing the specification
+  ContextCache *cache;			///< Private cache of the shared context database
+  DisassemblyCache *discache;		///< Private pool of ParserContext objects
+  PcodeCacher pcode_cache;		///< Private p-code staging area
+public:
+  SleighLifter(const Sleigh *sl);	///< Construct a lifter for the given translator
+  ~SleighLifter(void);			///< Destructor
+  void allowContextSet(bool val) { cache->allowSet(val); }	///< Toggle whether context changes are written back
+  int4 instructionLength(const Address &baseaddr) const;		///< Get the length of the instruction at the given address
+  int4 oneInstruction(PcodeEmit &emit,const Address &baseaddr);		///< Generate p-code for a single instruction
+  Address liftRange(PcodeEmit &emit,const Address &start,const Address &end);	///< Generate p-code for a run of instructions
+};
+
 /** \page sleigh SLEIGH
 
   \section sleightoc Table of Contents
@@ -185,40 +185,25 @@ void SleighBase::restoreXml(const Element *el)
   numSections = 0;
   int4 version = 0;
   setBigEndian(xml_readbool(el->getAttributeValue("bigendian")));
+  alignment = xml_readnumber(el->getAttributeValue("align"));
   {
-    istringstream s(el->getAttributeValue("align"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> alignment;
-  }
-  {
-    istringstream s(el->getAttributeValue("uniqbase"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    uintm ubase;
-    s >> ubase;
+    uintm ubase = xml_readnumber(el->getAttributeValue("uniqbase"));
     setUniqueBase(ubase);
   }
   int4 numattr = el->getNumAttributes();
   for(int4 i=0;i<numattr;++i) {
     const string &attrname( el->getAttributeName(i) );
     if (attrname == "maxdelay") {
-      istringstream s1(el->getAttributeValue(i));
-      s1.unsetf(ios::dec | ios::hex | ios::oct);
-      s1 >> maxdelayslotbytes;
+      maxdelayslotbytes = xml_readnumber(el->getAttributeValue(i));
     }
     else if (attrname == "uniqmask") {
-      istringstream s2(el->getAttributeValue(i));
-      s2.unsetf(ios::dec | ios::hex | ios::oct);
-      s2 >> unique_allocatemask;
+      unique_allocatemask = xml_readnumber(el->getAttributeValue(i));
     }
     else if (attrname == "numsections") {
-      istringstream s3(el->getAttributeValue(i));
-      s3.unsetf(ios::dec | ios::hex | ios::oct);
-      s3 >> numSections;
+      numSections = xml_readnumber(el->getAttributeValue(i));
     }
     else if (attrname == "version") {
-      istringstream s(el->getAttributeValue(i));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> version;
+      version = xml_readnumber(el->getAttributeValue(i));
     }
   }
   if (version != SLA_FORMAT_VERSION)
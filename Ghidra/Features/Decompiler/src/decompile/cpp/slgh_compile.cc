@@ -15,6 +15,7 @@
  */
 #include "slgh_compile.hh"
 #include "filemanage.hh"
+#include "packedxml.hh"
 #include <csignal>
 
 SleighCompile *slgh;		// Global pointer to sleigh object for use with parser
@@ -1480,6 +1481,165 @@ void SleighPcode::addSymbol(SleighSymbol *sym)
   return compiler->addSymbol(sym);
 }
 
+uint8 DecisionCache::hashBytes(uint8 h,const uint1 *ptr,int4 size)
+
+{ // Fold bytes into the running FNV-1a hash -h-
+  for(int4 i=0;i<size;++i) {
+    h ^= ptr[i];
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+uint8 DecisionCache::hashString(uint8 h,const string &str)
+
+{ // Fold a string and a terminator into the running hash -h-
+  h = hashBytes(h,(const uint1 *)str.c_str(),str.size());
+  uint1 term = 0;
+  return hashBytes(h,&term,1);
+}
+
+uint8 DecisionCache::hashSubtable(SubtableSymbol *sym)
+
+{ // Hash everything the decision tree of -sym- is built from: the pattern of each constructor, in id order
+  uint8 h = hashString(0xcbf29ce484222325ULL,"decision 1");
+  for(int4 i=0;i<sym->getNumConstructors();++i) {
+    ostringstream s;
+    s << dec << i;
+    sym->getConstructor(i)->getPattern()->getPattern()->saveXml(s);
+    h = hashString(h,s.str());
+  }
+  return h;
+}
+
+void DecisionCache::restoreErrors(SubtableSymbol *sym,const vector<pair<int4,int4> > &list,
+				  DecisionProperties &props,bool ident)
+
+{ // Replay the pattern errors saved with a tree, as if the tree had just been built
+  for(int4 i=0;i<list.size();++i) {
+    Constructor *a = sym->getConstructor(list[i].first);
+    Constructor *b = sym->getConstructor(list[i].second);
+    if (ident)
+      props.identicalPattern(a,b);
+    else
+      props.conflictingPattern(a,b);
+  }
+}
+
+void DecisionCache::load(void)
+
+{
+  ifstream f(filename.c_str(),ios::in|ios::binary);
+  if (!f) return;
+  string buf;
+  f.seekg(0,ios::end);
+  streamoff size = f.tellg();
+  f.seekg(0,ios::beg);
+  if (size > 0) {
+    buf.resize(size);
+    f.read(&buf[0],size);
+    buf.resize(f.gcount());
+  }
+  f.close();
+
+  istringstream s(buf);
+  for(;;) {
+    string tag;
+    s >> ws >> tag;
+    if (tag != "record") break;
+    DecisionCacheRecord rec;
+    uint8 key;
+    int4 numident,numconflict,xmllen;
+    s >> ws >> hex >> key >> ws >> dec >> numident >> ws >> numconflict >> ws >> xmllen;
+    if (!s || numident < 0 || numconflict < 0 || xmllen < 0) break;
+    for(int4 i=0;i<numident+numconflict;++i) {
+      int4 a,b;
+      s >> ws >> dec >> a >> ws >> b;
+      if (i < numident)
+	rec.identerrors.push_back(pair<int4,int4>(a,b));
+      else
+	rec.conflicterrors.push_back(pair<int4,int4>(a,b));
+    }
+    if (!s || s.get() != '\n') break;
+    rec.xml.resize(xmllen);
+    if (xmllen > 0)
+      s.read(&rec.xml[0],xmllen);
+    if (s.gcount() != xmllen || s.get() != '\n') break;	// Truncated record from an interrupted compile
+    records[key] = rec;
+  }
+}
+
+void DecisionCache::append(uint8 key,const DecisionCacheRecord &rec) const
+
+{
+  ostringstream s;
+  s << "record " << hex << key << ' ' << dec << rec.identerrors.size() << ' ' << rec.conflicterrors.size();
+  s << ' ' << rec.xml.size() << '\n';
+  for(int4 i=0;i<rec.identerrors.size();++i)
+    s << rec.identerrors[i].first << ' ' << rec.identerrors[i].second << '\n';
+  for(int4 i=0;i<rec.conflicterrors.size();++i)
+    s << rec.conflicterrors[i].first << ' ' << rec.conflicterrors[i].second << '\n';
+  s << rec.xml << '\n';
+
+  ofstream f(filename.c_str(),ios::out|ios::app|ios::binary);
+  if (!f)
+    throw LowlevelError("Unable to write decision tree cache: "+filename);
+  string out = s.str();
+  f.write(out.c_str(),out.size());
+  f.close();
+}
+
+DecisionCache::DecisionCache(const string &fname)
+
+{ // Open the cache, reading any records in the file -fname-
+  filename = fname;
+  hits = 0;
+  misses = 0;
+  load();
+}
+
+void DecisionCache::buildDecisionTree(SubtableSymbol *sym,DecisionProperties &props)
+
+{ // Restore the decision tree of -sym- if its patterns are in the cache, otherwise build and store it
+  if (sym->getPattern() == (TokenPattern *)0) return; // Pattern not fully formed
+  uint8 key = hashSubtable(sym);
+  map<uint8,DecisionCacheRecord>::const_iterator iter = records.find(key);
+  if (iter != records.end()) {
+    const DecisionCacheRecord &rec( (*iter).second );
+    Document *doc = (Document *)0;
+    try {
+      doc = xml_tree(rec.xml);
+    }
+    catch(XmlError &err) {
+      doc = (Document *)0;	// Damaged record, rebuild the tree
+    }
+    if (doc != (Document *)0) {
+      sym->restoreDecisionTree(doc->getRoot());
+      delete doc;
+      restoreErrors(sym,rec.identerrors,props,true);
+      restoreErrors(sym,rec.conflicterrors,props,false);
+      hits += 1;
+      return;
+    }
+  }
+  int4 identstart = props.getIdentErrors().size();
+  int4 conflictstart = props.getConflictErrors().size();
+  sym->buildDecisionTree(props);
+  DecisionCacheRecord rec;
+  const vector<pair<Constructor *,Constructor *> > &ierrors( props.getIdentErrors() );
+  for(int4 i=identstart;i<ierrors.size();++i)
+    rec.identerrors.push_back(pair<int4,int4>(ierrors[i].first->getId(),ierrors[i].second->getId()));
+  const vector<pair<Constructor *,Constructor *> > &cerrors( props.getConflictErrors() );
+  for(int4 i=conflictstart;i<cerrors.size();++i)
+    rec.conflicterrors.push_back(pair<int4,int4>(cerrors[i].first->getId(),cerrors[i].second->getId()));
+  ostringstream s;
+  sym->getDecisionTree()->saveXml(s);
+  rec.xml = s.str();
+  records[key] = rec;
+  append(key,rec);
+  misses += 1;
+}
+
 SleighCompile::SleighCompile(void)
   : SleighBase()
 {
@@ -1492,6 +1652,9 @@ SleighCompile::SleighCompile(void)
   lenientconflicterrors = true;
   warnalllocalcollisions = false;
   warnallnops = false;
+  printstats = false;
+  decisioncache = (DecisionCache *)0;
+  packedoutput = false;
   root = (SubtableSymbol *)0;
 }
 
@@ -1585,10 +1748,23 @@ void SleighCompile::buildDecisionTrees(void)
 
 {
   DecisionProperties props;
-  root->buildDecisionTree(props);
+  clock_t start = clock();
+  if (decisioncache != (DecisionCache *)0)
+    decisioncache->buildDecisionTree(root,props);
+  else
+    root->buildDecisionTree(props);
+  if (printstats)
+    tabletimes.push_back(pair<double,SubtableSymbol *>((double)(clock()-start)/CLOCKS_PER_SEC,root));
 
-  for(int4 i=0;i<tables.size();++i)
-    tables[i]->buildDecisionTree(props);
+  for(int4 i=0;i<tables.size();++i) {
+    start = clock();
+    if (decisioncache != (DecisionCache *)0)
+      decisioncache->buildDecisionTree(tables[i],props);
+    else
+      tables[i]->buildDecisionTree(props);
+    if (printstats)
+      tabletimes.push_back(pair<double,SubtableSymbol *>((double)(clock()-start)/CLOCKS_PER_SEC,tables[i]));
+  }
 
   const vector<pair<Constructor*, Constructor*> > &ierrors( props.getIdentErrors() );
   if (ierrors.size() != 0) {
@@ -1861,21 +2037,64 @@ uintb SleighCompile::getUniqueAddr(void)
   return base;
 }
 
+void SleighCompile::recordPhase(const string &nm,clock_t start)
+
+{ // Record time spent in phase -nm-, which started at -start-
+  if (!printstats) return;
+  phasetimes.push_back(pair<string,double>(nm,(double)(clock()-start)/CLOCKS_PER_SEC));
+}
+
+void SleighCompile::printStatistics(ostream &s) const
+
+{ // Report time spent in each phase, and the decision trees that took longest to build
+  if (!printstats) return;
+  s << "Compilation phases (seconds):" << endl;
+  double total = 0.0;
+  for(int4 i=0;i<phasetimes.size();++i) {
+    s << "  " << setw(24) << left << phasetimes[i].first << ' ' << fixed << setprecision(3) << phasetimes[i].second << endl;
+    total += phasetimes[i].second;
+  }
+  s << "  " << setw(24) << left << "total" << ' ' << fixed << setprecision(3) << total << endl;
+  if (decisioncache != (DecisionCache *)0)
+    s << "Decision tree cache: " << dec << decisioncache->getHits() << " restored, " << decisioncache->getMisses() << " built so far" << endl;
+  if (tabletimes.empty()) return;
+  vector<pair<double,SubtableSymbol *> > sorted(tabletimes);
+  sort(sorted.begin(),sorted.end());
+  s << "Slowest decision trees (of " << dec << sorted.size() << " subtables):" << endl;
+  int4 count = 0;
+  for(int4 i=sorted.size()-1;i>=0;--i) {
+    SubtableSymbol *sym = sorted[i].second;
+    s << "  " << setw(24) << left << sym->getName() << ' ' << fixed << setprecision(3) << sorted[i].first;
+    s << "  (" << dec << sym->getNumConstructors() << " constructors)" << endl;
+    count += 1;
+    if (count >= 10) break;
+  }
+}
+
 void SleighCompile::process(void)
 
 {				// Do all post processing on the parsed data structures
+  clock_t start = clock();
   checkNops();
   if (getDefaultCodeSpace() == (AddrSpace *)0)
     reportError("No default space specified");
   if (errors>0) return;
   checkConsistency();
+  recordPhase("consistency checks",start);
   if (errors>0) return;
+  start = clock();
   checkLocalCollisions();
+  recordPhase("local collisions",start);
   if (errors>0) return;
+  start = clock();
   buildPatterns();
+  recordPhase("patterns",start);
   if (errors>0) return;
+  start = clock();
   buildDecisionTrees();
+  recordPhase("decision trees",start);
   if (errors>0) return;
+  start = clock();
   vector<string> errorPairs;
   buildXrefs(errorPairs);		// Make sure we can build crossrefs properly
   if (!errorPairs.empty()) {
@@ -1889,6 +2108,7 @@ void SleighCompile::process(void)
   }
   checkUniqueAllocation();
   symtab.purge();		// Get rid of any symbols we don't plan to save
+  recordPhase("xrefs and uniques",start);
 }
 
 // Methods needed by the lexer
@@ -2773,19 +2993,32 @@ static int4 run_compilation(const char *filein,const char *fileout,SleighCompile
   }
 
   try {
+    clock_t start = clock();
     int4 parseres = yyparse();	// Try to parse
     fclose(yyin);
+    compiler.recordPhase("parse",start);
     if (parseres==0)
       compiler.process();	// Do all the post-processing
     if ((parseres==0)&&(compiler.numErrors()==0)) { // If no errors
-      ofstream s(fileout);
+      start = clock();
+      ofstream s(fileout,compiler.isPackedOutput() ? ios::out|ios::binary : ios::out);
       if (!s) {
 	ostringstream errs;
 	errs << "Unable to open output file: " << fileout;
 	throw SleighError(errs.str());
       }
-      compiler.saveXml(s);	// Dump output xml
+      if (compiler.isPackedOutput()) {
+	ostringstream xml;
+	compiler.saveXml(xml);
+	string packed;
+	packed_transcode(xml.str(),packed);	// Binary image read back by DocumentStorage::openDocument
+	s.write(packed.c_str(),packed.size());
+      }
+      else
+	compiler.saveXml(s);	// Dump output xml
       s.close();
+      compiler.recordPhase("write output",start);
+      compiler.printStatistics(cout);
     }
     else {
       cerr << "No output produced" <<endl;
@@ -2869,7 +3102,8 @@ static void findSlaSpecs(vector<string> &res, const string &dir, const string &s
 
 static void initCompiler(SleighCompile &compiler, map<string,string> &defines, bool enableUnnecessaryPcodeWarning,
 			 bool disableLenientConflict, bool enableAllCollisionWarning,
-			 bool enableAllNopWarning,bool enableDeadTempWarning,bool enforceLocalKeyWord)
+			 bool enableAllNopWarning,bool enableDeadTempWarning,bool enforceLocalKeyWord,
+			 bool enablePhaseStatistics,DecisionCache *decisionCache,bool enablePackedOutput)
 
 {
   map<string,string>::iterator iter = defines.begin();
@@ -2888,6 +3122,11 @@ static void initCompiler(SleighCompile &compiler, map<string,string> &defines, b
     compiler.setDeadTempWarning(true);
   if (enforceLocalKeyWord)
     compiler.setEnforceLocalKeyWord(true);
+  if (enablePhaseStatistics)
+    compiler.setPhaseStatistics(true);
+  compiler.setDecisionCache(decisionCache);
+  if (enablePackedOutput)
+    compiler.setPackedOutput(true);
 }
 
 static void segvHandler(int sig) {
@@ -2914,6 +3153,9 @@ int main(int argc,char **argv)
     cerr << "   -n              print warnings for all NOP constructors" << endl;
     cerr << "   -t              print warnings for dead temporaries" << endl;
     cerr << "   -e              enforce use of 'local' keyword for temporaries" << endl;
+    cerr << "   -s              print time spent in each compilation phase" << endl;
+    cerr << "   -kFILE          reuse decision trees cached in FILE by earlier compiles" << endl;
+    cerr << "   -b              write the .sla in the packed binary encoding (not readable by Ghidra's Java side)" << endl;
     cerr << "   -c              print warnings for all constructors with colliding operands" << endl;
     cerr << "   -DNAME=VALUE    defines a preprocessor macro NAME with value VALUE" << endl;
     exit(2);
@@ -2928,6 +3170,9 @@ int main(int argc,char **argv)
   bool enableAllNopWarning = false;
   bool enableDeadTempWarning = false;
   bool enforceLocalKeyWord = false;
+  bool enablePhaseStatistics = false;
+  string decisionCacheFile;
+  bool enablePackedOutput = false;
   
   bool compileAll = false;
   
@@ -2959,6 +3204,17 @@ int main(int argc,char **argv)
       enableDeadTempWarning = true;
     else if (argv[i][1] == 'e')
       enforceLocalKeyWord = true;
+    else if (argv[i][1] == 's')
+      enablePhaseStatistics = true;
+    else if (argv[i][1] == 'b')
+      enablePackedOutput = true;
+    else if (argv[i][1] == 'k') {
+      decisionCacheFile = argv[i]+2;
+      if (decisionCacheFile.empty()) {
+	cerr << "Bad sleigh option: "<< argv[i] << endl;
+	exit(1);
+      }
+    }
 #ifdef YYDEBUG
     else if (argv[i][1] == 'x')
       yydebug = 1;		// Debug option
@@ -2969,6 +3225,10 @@ int main(int argc,char **argv)
     }
   }
   
+  DecisionCache *decisionCache = (DecisionCache *)0;
+  if (!decisionCacheFile.empty())
+    decisionCache = new DecisionCache(decisionCacheFile);
+
   if (compileAll) {
     
     if (i< argc-1) {
@@ -2991,7 +3251,8 @@ int main(int argc,char **argv)
       SleighCompile compiler;
       initCompiler(compiler, defines, enableUnnecessaryPcodeWarning, 
 		   disableLenientConflict, enableAllCollisionWarning, enableAllNopWarning,
-		   enableDeadTempWarning, enforceLocalKeyWord);
+		   enableDeadTempWarning, enforceLocalKeyWord, enablePhaseStatistics,
+		   decisionCache, enablePackedOutput);
       retval = run_compilation(slaspec.c_str(),sla.c_str(),compiler);
       if (retval != 0) {
 	return retval; // stop on first error
@@ -3028,7 +3289,8 @@ int main(int argc,char **argv)
     SleighCompile compiler;
     initCompiler(compiler, defines, enableUnnecessaryPcodeWarning, 
 		 disableLenientConflict, enableAllCollisionWarning, enableAllNopWarning,
-		 enableDeadTempWarning, enforceLocalKeyWord);
+		 enableDeadTempWarning, enforceLocalKeyWord, enablePhaseStatistics,
+		 decisionCache, enablePackedOutput);
     
     if (i < argc - 1) {
       string fileoutExamine(argv[i+1]);
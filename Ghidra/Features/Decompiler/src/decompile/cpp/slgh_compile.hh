@@ -18,6 +18,7 @@
 #include "filemanage.hh"
 #include <iostream>
 #include <sstream>
+#include <ctime>
 
 // High-level control of the sleigh compilation process
 
@@ -164,6 +165,36 @@ public:
   virtual void appendCrossBuild(OpTpl *bld,int4 secnum) { dump(bld); }
 };
 
+struct DecisionCacheRecord {	// A decision tree saved by a previous compile
+  vector<pair<int4,int4> > identerrors;	// Ids of constructors found to have identical patterns
+  vector<pair<int4,int4> > conflicterrors; // Ids of constructors found to have conflicting patterns
+  string xml;			// The <decision> tag of the tree
+};
+
+// Persistent, append-only store of decision trees.  Each tree is keyed by a hash of
+// the patterns of every constructor in its subtable, so a subtable whose patterns are
+// unchanged since an earlier compile is restored instead of rebuilt.  The pattern errors
+// found while building are saved with the tree and replayed on a restore.  The whole
+// file is read when the cache is opened, and a later record replaces an earlier one.
+class DecisionCache {
+  string filename;		// Path of the backing file
+  map<uint8,DecisionCacheRecord> records;
+  int4 hits;			// Number of trees restored
+  int4 misses;			// Number of trees built and stored
+  static uint8 hashBytes(uint8 h,const uint1 *ptr,int4 size);
+  static uint8 hashString(uint8 h,const string &str);
+  static uint8 hashSubtable(SubtableSymbol *sym);
+  static void restoreErrors(SubtableSymbol *sym,const vector<pair<int4,int4> > &list,
+			    DecisionProperties &props,bool ident);
+  void load(void);
+  void append(uint8 key,const DecisionCacheRecord &rec) const;
+public:
+  DecisionCache(const string &fname);
+  void buildDecisionTree(SubtableSymbol *sym,DecisionProperties &props);
+  int4 getHits(void) const { return hits; }
+  int4 getMisses(void) const { return misses; }
+};
+
 class SleighPcode : public PcodeCompile {
   SleighCompile *compiler;
   virtual uintb allocateTemp(void);
@@ -203,6 +234,11 @@ private:
   bool warnalllocalcollisions;	// True if local export collisions generate individual warnings
   bool warnallnops;		// True if pcode NOPs generate individual warnings
   vector<string> noplist;	// List of individual NOP warnings
+  bool printstats;		// True if time spent in each compilation phase is reported
+  vector<pair<string,double> > phasetimes;	// Seconds spent in each phase, in order
+  vector<pair<double,SubtableSymbol *> > tabletimes;	// Seconds spent building each decision tree
+  DecisionCache *decisioncache;	// Decision trees saved by earlier compiles (if not null)
+  bool packedoutput;		// True if the .sla is written in the packed binary encoding
   mutable Location currentLocCache;	// Location for (last) request of current location
   int4 errors;
 
@@ -247,6 +283,12 @@ public:
   void setLenientConflict(bool val) { lenientconflicterrors = val; }
   void setLocalCollisionWarning(bool val) { warnalllocalcollisions = val; }
   void setAllNopWarning(bool val) { warnallnops = val; }
+  void setPhaseStatistics(bool val) { printstats = val; }
+  void setDecisionCache(DecisionCache *cache) { decisioncache = cache; }
+  void setPackedOutput(bool val) { packedoutput = val; }
+  bool isPackedOutput(void) const { return packedoutput; }
+  void recordPhase(const string &nm,clock_t start);
+  void printStatistics(ostream &s) const;
   void process(void);
 
   // Lexer functions
@@ -622,31 +622,11 @@ void TokenField::restoreXml(const Element *el,Translate *trans)
   tok = (Token *)0;
   bigendian = xml_readbool(el->getAttributeValue("bigendian"));
   signbit = xml_readbool(el->getAttributeValue("signbit"));
-  {
-    istringstream s(el->getAttributeValue("bitstart"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> bitstart;
-  }
-  {
-    istringstream s(el->getAttributeValue("bitend"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> bitend;
-  }
-  {
-    istringstream s(el->getAttributeValue("bytestart"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> bytestart;
-  }
-  {
-    istringstream s(el->getAttributeValue("byteend"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> byteend;
-  }
-  {
-    istringstream s(el->getAttributeValue("shift"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> shift;
-  }
+  bitstart = xml_readnumber(el->getAttributeValue("bitstart"));
+  bitend = xml_readnumber(el->getAttributeValue("bitend"));
+  bytestart = xml_readnumber(el->getAttributeValue("bytestart"));
+  byteend = xml_readnumber(el->getAttributeValue("byteend"));
+  shift = xml_readnumber(el->getAttributeValue("shift"));
 }
 
 ContextField::ContextField(bool s,int4 sbit,int4 ebit)
@@ -698,31 +678,11 @@ void ContextField::restoreXml(const Element *el,Translate *trans)
 
 {
   signbit = xml_readbool(el->getAttributeValue("signbit"));
-  {
-    istringstream s(el->getAttributeValue("startbit"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> startbit;
-  }
-  {
-    istringstream s(el->getAttributeValue("endbit"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> endbit;
-  }
-  {
-    istringstream s(el->getAttributeValue("startbyte"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> startbyte;
-  }
-  {
-    istringstream s(el->getAttributeValue("endbyte"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> endbyte;
-  }
-  {
-    istringstream s(el->getAttributeValue("shift"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> shift;
-  }
+  startbit = xml_readnumber(el->getAttributeValue("startbit"));
+  endbit = xml_readnumber(el->getAttributeValue("endbit"));
+  startbyte = xml_readnumber(el->getAttributeValue("startbyte"));
+  endbyte = xml_readnumber(el->getAttributeValue("endbyte"));
+  shift = xml_readnumber(el->getAttributeValue("shift"));
 }
 
 void ConstantValue::saveXml(ostream &s) const
@@ -734,9 +694,7 @@ void ConstantValue::saveXml(ostream &s) const
 void ConstantValue::restoreXml(const Element *el,Translate *trans)
 
 {
-  istringstream s(el->getAttributeValue("val"));
-  s.unsetf(ios::dec | ios::hex | ios::oct);
-  s >> val;
+  val = xml_readnumber(el->getAttributeValue("val"));
 }
 
 TokenPattern OperandValue::genPattern(intb val) const
@@ -820,21 +778,9 @@ void OperandValue::restoreXml(const Element *el,Translate *trans)
 
 {
   uintm ctid,tabid;
-  {
-    istringstream s(el->getAttributeValue("index"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> index;
-  }
-  {
-    istringstream s(el->getAttributeValue("table"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> tabid;
-  }
-  {
-    istringstream s(el->getAttributeValue("ct"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> ctid;
-  }
+  index = xml_readnumber(el->getAttributeValue("index"));
+  tabid = xml_readnumber(el->getAttributeValue("table"));
+  ctid = xml_readnumber(el->getAttributeValue("ct"));
   SleighBase *sleigh = (SleighBase *)trans;
   SubtableSymbol *tab = dynamic_cast<SubtableSymbol *>(sleigh->findSymbol(tabid));
   ct = tab->getConstructor(ctid);
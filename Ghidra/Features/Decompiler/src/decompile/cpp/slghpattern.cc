@@ -500,32 +500,16 @@ void PatternBlock::saveXml(ostream &s) const
 void PatternBlock::restoreXml(const Element *el)
 
 {
-  {
-    istringstream s(el->getAttributeValue("offset"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> offset;
-  }
-  {
-    istringstream s(el->getAttributeValue("nonzero"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> nonzerosize;
-  }
+  offset = xml_readnumber(el->getAttributeValue("offset"));
+  nonzerosize = xml_readnumber(el->getAttributeValue("nonzero"));
   const List &list(el->getChildren());
   List::const_iterator iter;
   iter = list.begin();
   uintm mask,val;
   while(iter != list.end()) {
     Element *subel = *iter;
-    {
-      istringstream s(subel->getAttributeValue("mask"));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> mask;
-    }
-    {
-      istringstream s(subel->getAttributeValue("val"));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> val;
-    }
+    mask = xml_readnumber(subel->getAttributeValue("mask"));
+    val = xml_readnumber(subel->getAttributeValue("val"));
     maskvec.push_back(mask);
     valvec.push_back(val);
     ++iter;
@@ -37,6 +37,9 @@ public:
   PatternBlock *clone(void) const;
   void shift(int4 sa) { offset += sa; normalize(); }
   int4 getLength(void) const { return offset+nonzerosize; }
+  int4 getOffset(void) const { return offset; }
+  const vector<uintm> &getMaskVector(void) const { return maskvec; }
+  const vector<uintm> &getValueVector(void) const { return valvec; }
   uintm getMask(int4 startbit,int4 size) const;
   uintm getValue(int4 startbit,int4 size) const;
   bool alwaysTrue(void) const { return (nonzerosize==0); }
@@ -71,6 +74,7 @@ class DisjointPattern : public Pattern { // A pattern with no ORs in it
 public:
   virtual int4 numDisjoint(void) const { return 0; }
   virtual DisjointPattern *getDisjoint(int4 i) const { return (DisjointPattern *)0; }
+  const PatternBlock *getMatchBlock(bool context) const { return getBlock(context); } // Block tested by isMatch (may be null)
   uintm getMask(int4 startbit,int4 size,bool context) const;
   uintm getValue(int4 startbit,int4 size,bool context) const;
   int4 getLength(bool context) const;
@@ -167,16 +167,12 @@ void SymbolTable::restoreXml(const Element *el,SleighBase *trans)
 {
   {
     uint4 size;
-    istringstream s(el->getAttributeValue("scopesize"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> size;
+    size = xml_readnumber(el->getAttributeValue("scopesize"));
     table.resize(size,(SymbolScope *)0);
   }
   {
     uint4 size;
-    istringstream s(el->getAttributeValue("symbolsize"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> size;
+    size = xml_readnumber(el->getAttributeValue("symbolsize"));
     symbollist.resize(size,(SleighSymbol *)0);
   }
   const List &list(el->getChildren());
@@ -188,16 +184,8 @@ void SymbolTable::restoreXml(const Element *el,SleighBase *trans)
       throw SleighError("Misnumbered symbol scopes");
     uintm id;
     uintm parent;
-    {
-      istringstream s(subel->getAttributeValue("id"));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> id;
-    }
-    {
-      istringstream s(subel->getAttributeValue("parent"));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> parent;
-    }
+    id = xml_readnumber(subel->getAttributeValue("id"));
+    parent = xml_readnumber(subel->getAttributeValue("parent"));
     SymbolScope *parscope = (parent==id) ? (SymbolScope *)0 : table[parent];
     table[id] = new SymbolScope( parscope, id );
     ++iter;
@@ -214,11 +202,7 @@ void SymbolTable::restoreXml(const Element *el,SleighBase *trans)
     Element *subel = *iter;
     uintm id;
     SleighSymbol *sym;
-    {
-      istringstream s(subel->getAttributeValue("id"));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> id;
-    }
+    id = xml_readnumber(subel->getAttributeValue("id"));
     sym = findSymbol(id);
     sym->restoreXml(subel,trans);
     ++iter;
@@ -366,16 +350,8 @@ void SleighSymbol::restoreXmlHeader(const Element *el)
 
 {
   name = el->getAttributeValue("name");
-  {
-    istringstream s(el->getAttributeValue("id"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> id;
-  }
-  {
-    istringstream s(el->getAttributeValue("scope"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> scopeid;
-  }
+  id = xml_readnumber(el->getAttributeValue("id"));
+  scopeid = xml_readnumber(el->getAttributeValue("scope"));
 }
 
 void UserOpSymbol::saveXml(ostream &s) const
@@ -398,9 +374,7 @@ void UserOpSymbol::saveXmlHeader(ostream &s) const
 void UserOpSymbol::restoreXml(const Element *el,SleighBase *trans)
 
 {
-  istringstream s(el->getAttributeValue("index"));
-  s.unsetf(ios::dec | ios::hex | ios::oct);
-  s >> index;
+  index = xml_readnumber(el->getAttributeValue("index"));
 }
 
 PatternlessSymbol::PatternlessSymbol(void)
@@ -612,10 +586,7 @@ void ValueMapSymbol::restoreXml(const Element *el,SleighBase *trans)
   patval->layClaim();
   ++iter;
   while(iter != list.end()) {
-    istringstream s((*iter)->getAttributeValue("val"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    intb val;
-    s >> val;
+    intb val = xml_readnumber((*iter)->getAttributeValue("val"));
     valuetable.push_back(val);
     ++iter;
   }
@@ -760,16 +731,8 @@ void VarnodeSymbol::restoreXml(const Element *el,SleighBase *trans)
 
 {
   fix.space = trans->getSpaceByName(el->getAttributeValue("space"));
-  {
-    istringstream s(el->getAttributeValue("offset"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> fix.offset;
-  }
-  {
-    istringstream s(el->getAttributeValue("size"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> fix.size;
-  }
+  fix.offset = xml_readnumber(el->getAttributeValue("offset"));
+  fix.size = xml_readnumber(el->getAttributeValue("size"));
 				// PatternlessSymbol does not need restoring
 }
 
@@ -811,20 +774,14 @@ void ContextSymbol::restoreXml(const Element *el,SleighBase *trans)
   ValueSymbol::restoreXml(el,trans);
   {
     uintm id;
-    istringstream s(el->getAttributeValue("varnode"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> id;
+    id = xml_readnumber(el->getAttributeValue("varnode"));
     vn = (VarnodeSymbol *)trans->findSymbol(id);
   }
   {  
-    istringstream s(el->getAttributeValue("low"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> low;
+    low = xml_readnumber(el->getAttributeValue("low"));
   }
   {  
-    istringstream s(el->getAttributeValue("high"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> high;
+    high = xml_readnumber(el->getAttributeValue("high"));
   }
   flow = true;
   for(int4 i=el->getNumAttributes()-1;i>=0;--i) {
@@ -940,9 +897,7 @@ void VarnodeListSymbol::restoreXml(const Element *el,SleighBase *trans)
     const Element *subel = *iter;
     if (subel->getName() == "var") {
       uintm id;
-      istringstream s(subel->getAttributeValue("id"));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> id;
+      id = xml_readnumber(subel->getAttributeValue("id"));
       varnode_table.push_back( (VarnodeSymbol *)trans->findSymbol(id) );
     }
     else
@@ -1081,32 +1036,14 @@ void OperandSymbol::restoreXml(const Element *el,SleighBase *trans)
   defexp = (PatternExpression *)0;
   triple = (TripleSymbol *)0;
   flags = 0;
-  {
-    istringstream s(el->getAttributeValue("index"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> hand;
-  }
-  {
-    istringstream s(el->getAttributeValue("off"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> reloffset;
-  }
-  {
-    istringstream s(el->getAttributeValue("base"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> offsetbase;
-  }
-  {
-    istringstream s(el->getAttributeValue("minlen"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> minimumlength;
-  }
+  hand = xml_readnumber(el->getAttributeValue("index"));
+  reloffset = xml_readnumber(el->getAttributeValue("off"));
+  offsetbase = xml_readnumber(el->getAttributeValue("base"));
+  minimumlength = xml_readnumber(el->getAttributeValue("minlen"));
   for(int4 i=0;i<el->getNumAttributes();++i) {
     if (el->getAttributeName(i) == "subsym") {
       uintm id;
-      istringstream s(el->getAttributeValue(i));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> id;
+      id = xml_readnumber(el->getAttributeValue(i));
       triple = (TripleSymbol *)trans->findSymbol(id);
     }
     else if (el->getAttributeName(i) == "code") {
@@ -1627,37 +1564,19 @@ void Constructor::restoreXml(const Element *el,SleighBase *trans)
 {
   uintm id;
   {
-    istringstream s(el->getAttributeValue("parent"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> id;
+    id = xml_readnumber(el->getAttributeValue("parent"));
     parent = (SubtableSymbol *)trans->findSymbol(id);
   }
-  {
-    istringstream s(el->getAttributeValue("first"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> firstwhitespace;
-  }
-  {
-    istringstream s(el->getAttributeValue("length"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> minimumlength;
-  }
-  {
-    istringstream s(el->getAttributeValue("line"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> lineno;
-  }
+  firstwhitespace = xml_readnumber(el->getAttributeValue("first"));
+  minimumlength = xml_readnumber(el->getAttributeValue("length"));
+  lineno = xml_readnumber(el->getAttributeValue("line"));
   const List &list(el->getChildren());
   List::const_iterator iter;
   iter = list.begin();
   while(iter != list.end()) {
     if ((*iter)->getName() == "oper") {
       uintm id;
-      {
-	istringstream s((*iter)->getAttributeValue("id"));
-	s.unsetf(ios::dec | ios::hex | ios::oct);
-	s >> id;
-      }
+      id = xml_readnumber((*iter)->getAttributeValue("id"));
       OperandSymbol *sym = (OperandSymbol *)trans->findSymbol(id);
       operands.push_back(sym);
     }
@@ -1665,9 +1584,7 @@ void Constructor::restoreXml(const Element *el,SleighBase *trans)
       printpiece.push_back( (*iter)->getAttributeValue("piece"));
     else if ((*iter)->getName() == "opprint") {
       int4 index;
-      istringstream s((*iter)->getAttributeValue("id"));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> index;
+      index = xml_readnumber((*iter)->getAttributeValue("id"));
       string operstring = "\n ";
       operstring[1] = ('A' + index);
       printpiece.push_back(operstring);
@@ -1932,9 +1849,7 @@ void SubtableSymbol::restoreXml(const Element *el,SleighBase *trans)
 {
   {
     int4 numct;
-    istringstream s(el->getAttributeValue("numct"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> numct;
+    numct = xml_readnumber(el->getAttributeValue("numct"));
     construct.reserve(numct);
   }
   const List &list(el->getChildren());
@@ -1946,10 +1861,8 @@ void SubtableSymbol::restoreXml(const Element *el,SleighBase *trans)
       addConstructor(ct);
       ct->restoreXml(*iter,trans);
     }
-    else if ((*iter)->getName() == "decision") {
-      decisiontree = new DecisionNode();
-      decisiontree->restoreXml(*iter,(DecisionNode *)0,this);
-    }
+    else if ((*iter)->getName() == "decision")
+      restoreDecisionTree(*iter);
     ++iter;
   }
   pattern = (TokenPattern *)0;
@@ -1972,6 +1885,15 @@ void SubtableSymbol::buildDecisionTree(DecisionProperties &props)
 	decisiontree->addConstructorPair(pat->getDisjoint(j),construct[i]);
   }
   decisiontree->split(props);	// Create the decision strategy
+  decisiontable.build(decisiontree);
+}
+
+void SubtableSymbol::restoreDecisionTree(const Element *el)
+
+{				// Recover a decision tree saved by DecisionNode::saveXml
+  decisiontree = new DecisionNode();
+  decisiontree->restoreXml(el,(DecisionNode *)0,this);
+  decisiontable.build(decisiontree);
 }
 
 TokenPattern *SubtableSymbol::buildPattern(ostream &s)
@@ -2376,22 +2298,10 @@ void DecisionNode::restoreXml(const Element *el,DecisionNode *par,SubtableSymbol
 
 {
   parent = par;
-  {
-    istringstream s(el->getAttributeValue("number"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> num;
-  }
+  num = xml_readnumber(el->getAttributeValue("number"));
   contextdecision = xml_readbool(el->getAttributeValue("context"));
-  {
-    istringstream s(el->getAttributeValue("start"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> startbit;
-  }
-  {
-    istringstream s(el->getAttributeValue("size"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> bitsize;
-  }
+  startbit = xml_readnumber(el->getAttributeValue("start"));
+  bitsize = xml_readnumber(el->getAttributeValue("size"));
   const List &childlist(el->getChildren());
   List::const_iterator iter;
   iter = childlist.begin();
@@ -2400,9 +2310,7 @@ void DecisionNode::restoreXml(const Element *el,DecisionNode *par,SubtableSymbol
       Constructor *ct;
       DisjointPattern *pat;
       uintm id;
-      istringstream s((*iter)->getAttributeValue("id"));
-      s.unsetf(ios::dec | ios::hex | ios::oct);
-      s >> id;
+      id = xml_readnumber((*iter)->getAttributeValue("id"));
       ct = sub->getConstructor(id);
       pat = DisjointPattern::restoreDisjoint((*iter)->getChildren().front());
       //This increments num      addConstructorPair(pat,ct);
@@ -2418,6 +2326,119 @@ void DecisionNode::restoreXml(const Element *el,DecisionNode *par,SubtableSymbol
   }
 }
 
+void DecisionTable::clear(void)
+
+{
+  nodes.clear();
+  jump.clear();
+  leaves.clear();
+  checks.clear();
+}
+
+void DecisionTable::build(const DecisionNode *root)
+
+{ // Flatten the tree rooted at -root-, replacing any previous table
+  clear();
+  addNode(root);
+}
+
+int4 DecisionTable::addNode(const DecisionNode *node)
+
+{ // Append -node- and everything below it, return its index
+  int4 index = nodes.size();
+  nodes.push_back(Node());
+  nodes[index].context = node->contextdecision;
+  nodes[index].startbit = node->startbit;
+  nodes[index].bitsize = node->bitsize;
+  if (node->bitsize == 0) {	// Terminal node
+    nodes[index].start = leaves.size();
+    for(int4 i=0;i<node->list.size();++i) {
+      Leaf leaf;
+      leaf.ct = node->list[i].second;
+      leaf.start = checks.size();
+      leaf.never = false;
+      // Same order as CombinePattern::isMatch: instruction first, then context
+      addBlock(node->list[i].first->getMatchBlock(false),false,leaf);
+      addBlock(node->list[i].first->getMatchBlock(true),true,leaf);
+      leaf.end = checks.size();
+      leaves.push_back(leaf);
+    }
+    nodes[index].end = leaves.size();
+  }
+  else {
+    int4 base = jump.size();
+    jump.resize(base + node->children.size());
+    nodes[index].start = base;
+    nodes[index].end = jump.size();
+    for(int4 i=0;i<node->children.size();++i) {
+      int4 child = addNode(node->children[i]);
+      jump[base + i] = child;
+    }
+  }
+  return index;
+}
+
+void DecisionTable::addBlock(const PatternBlock *block,bool context,Leaf &leaf)
+
+{ // Add the word tests of -block- to the leaf being built
+  if (block == (const PatternBlock *)0) return;
+  if (block->alwaysFalse()) {
+    leaf.never = true;
+    return;
+  }
+  if (block->alwaysTrue()) return;
+  const vector<uintm> &maskvec(block->getMaskVector());
+  const vector<uintm> &valvec(block->getValueVector());
+  int4 off = block->getOffset();
+  for(int4 i=0;i<maskvec.size();++i) {
+    Check check;
+    check.context = context;
+    check.offset = off;
+    check.mask = maskvec[i];
+    check.value = valvec[i];
+    checks.push_back(check);
+    off += sizeof(uintm);
+  }
+}
+
+bool DecisionTable::isMatch(const Leaf &leaf,ParserWalker &walker) const
+
+{
+  if (leaf.never) return false;
+  for(int4 i=leaf.start;i<leaf.end;++i) {
+    const Check &check(checks[i]);
+    uintm data;
+    if (check.context)
+      data = walker.getContextBytes(check.offset,sizeof(uintm));
+    else
+      data = walker.getInstructionBytes(check.offset,sizeof(uintm));
+    if ((check.mask & data) != check.value) return false;
+  }
+  return true;
+}
+
+Constructor *DecisionTable::resolve(ParserWalker &walker) const
+
+{ // Same result as DecisionNode::resolve on the tree this was built from
+  const Node *node = &nodes[0];
+  while(node->bitsize != 0) {
+    uintm val;
+    if (node->context)
+      val = walker.getContextBits(node->startbit,node->bitsize);
+    else
+      val = walker.getInstructionBits(node->startbit,node->bitsize);
+    node = &nodes[ jump[node->start + val] ];
+  }
+  for(int4 i=node->start;i<node->end;++i)
+    if (isMatch(leaves[i],walker))
+      return leaves[i].ct;
+  ostringstream s;
+  s << walker.getAddr().getShortcut();
+  walker.getAddr().printRaw(s);
+  s << ": Unable to resolve constructor";
+  throw BadDataError(s.str());
+}
+
 static void calc_maskword(int4 sbit,int4 ebit,int4 &num,int4 &shift,uintm &mask)
 
 {
@@ -2480,21 +2501,9 @@ void ContextOp::saveXml(ostream &s) const
 void ContextOp::restoreXml(const Element *el,SleighBase *trans)
 
 {
-  {
-    istringstream s(el->getAttributeValue("i"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> num;
-  }
-  {
-    istringstream s(el->getAttributeValue("shift"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> shift;
-  }
-  {
-    istringstream s(el->getAttributeValue("mask"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> mask;
-  }
+  num = xml_readnumber(el->getAttributeValue("i"));
+  shift = xml_readnumber(el->getAttributeValue("shift"));
+  mask = xml_readnumber(el->getAttributeValue("mask"));
   const List &list(el->getChildren());
   List::const_iterator iter;
   iter = list.begin();
@@ -2545,21 +2554,11 @@ void ContextCommit::restoreXml(const Element *el,SleighBase *trans)
 {
   uintm id;
   {
-    istringstream s(el->getAttributeValue("id"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> id;
+    id = xml_readnumber(el->getAttributeValue("id"));
     sym = (TripleSymbol *)trans->findSymbol(id);
   }
-  {
-    istringstream s(el->getAttributeValue("num"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> num;
-  }
-  {
-    istringstream s(el->getAttributeValue("mask"));
-    s.unsetf(ios::dec | ios::hex | ios::oct);
-    s >> mask;
-  }
+  num = xml_readnumber(el->getAttributeValue("num"));
+  mask = xml_readnumber(el->getAttributeValue("mask"));
   if (el->getNumAttributes()==4)
     flow = xml_readbool(el->getAttributeValue("flow"));
   else
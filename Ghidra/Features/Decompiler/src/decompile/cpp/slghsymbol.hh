@@ -535,6 +535,7 @@ public:
 };
 
 class DecisionNode {
+  friend class DecisionTable;
   vector<pair<DisjointPattern *,Constructor *> > list;
   vector<DecisionNode *> children;
   int4 num;			// Total number of patterns we distinguish
@@ -558,11 +559,46 @@ public:
   void restoreXml(const Element *el,DecisionNode *par,SubtableSymbol *sub);
 };
 
+// The DecisionNode tree flattened into arrays, so that resolving a Constructor
+// is a loop of table lookups instead of a recursive walk over heap nodes.
+// Leaf patterns are reduced to lists of masked-value word tests, in the same
+// order DisjointPattern::isMatch would perform them.
+class DecisionTable {
+  struct Node {
+    bool context;		// True if the decision is based on context
+    int4 startbit,bitsize;	// Bits on which to base the decision (bitsize==0 for a terminal)
+    int4 start,end;		// Range of jump entries, or of leaves for a terminal
+  };
+  struct Leaf {
+    Constructor *ct;		// Constructor resolved by this pattern
+    int4 start,end;		// Range of checks that must all pass
+    bool never;			// True if the pattern can never match
+  };
+  struct Check {
+    bool context;		// True if the word comes from context
+    int4 offset;		// Byte offset of the word
+    uintm mask;			// Mask applied to the word
+    uintm value;		// Value the masked word must equal
+  };
+  vector<Node> nodes;		// All nodes, the root is first
+  vector<int4> jump;		// Index of child node for each value of a decision field
+  vector<Leaf> leaves;		// Patterns of all terminal nodes
+  vector<Check> checks;		// Word tests of all patterns
+  int4 addNode(const DecisionNode *node);
+  void addBlock(const PatternBlock *block,bool context,Leaf &leaf);
+  bool isMatch(const Leaf &leaf,ParserWalker &walker) const;
+public:
+  void clear(void);
+  void build(const DecisionNode *root);
+  Constructor *resolve(ParserWalker &walker) const;
+};
+
 class SubtableSymbol : public TripleSymbol {
   TokenPattern *pattern;
   bool beingbuilt,errors;
   vector<Constructor *> construct; // All the Constructors in this table
   DecisionNode *decisiontree;
+  DecisionTable decisiontable;	// Flattened form of decisiontree used by resolve
 public:
   SubtableSymbol(void) { pattern = (TokenPattern *)0; decisiontree = (DecisionNode *)0; } // For use with restoreXml
   SubtableSymbol(const string &nm);
@@ -571,11 +607,13 @@ public:
   bool isError(void) const { return errors; }
   void addConstructor(Constructor *ct) { ct->setId(construct.size()); construct.push_back(ct); }
   void buildDecisionTree(DecisionProperties &props);
+  void restoreDecisionTree(const Element *el);
+  DecisionNode *getDecisionTree(void) const { return decisiontree; }
   TokenPattern *buildPattern(ostream &s);
   TokenPattern *getPattern(void) const { return pattern; }
   int4 getNumConstructors(void) const { return construct.size(); }
   Constructor *getConstructor(uintm id) const { return construct[id]; }
-  virtual Constructor *resolve(ParserWalker &walker) { return decisiontree->resolve(walker); }
+  virtual Constructor *resolve(ParserWalker &walker) { return decisiontable.resolve(walker); }
   virtual PatternExpression *getPatternExpression(void) const { throw SleighError("Cannot use subtable in expression"); }
   virtual void getFixedHandle(FixedHandle &hand,ParserWalker &walker) const {
     throw SleighError("Cannot use subtable in expression"); }
@@ -346,6 +346,24 @@ public:
   /// \param val is \b true to allow context changes, \b false prevents changes
   virtual void allowContextSet(bool val) const {}
 
+  /// \brief Set the size of the cache of parsed instructions
+  ///
+  /// A translator may keep recently parsed instructions so that translating the same
+  /// address again does not require parsing it again. The cache holds at least \b cachesize
+  /// instructions, and looks them up through a hashtable with \b windowsize entries.
+  /// Passing 0 for either value restores the translator's default.
+  /// \param cachesize is the number of parsed instructions to keep
+  /// \param windowsize is the number of hashtable entries (a power of 2)
+  virtual void setParserCacheSize(int4 cachesize,int4 windowsize) const {}
+
+  /// \brief Print usage statistics of the cache of parsed instructions
+  ///
+  /// \param s is the stream to write to
+  virtual void printParserCacheStatistics(ostream &s) const {}
+
+  /// \brief Reset usage statistics of the cache of parsed instructions
+  virtual void resetParserCacheStatistics(void) const {}
+
   /// \brief Add a named register to the model for this processor
   ///
   /// \deprecated All registers used to be formally added to the
@@ -840,7 +840,9 @@ void Varnode::saveXml(ostream &s) const
 /// \param uspace is the \e unique space
 /// \param ubase is the base offset for allocating temporaries
 VarnodeBank::VarnodeBank(AddrSpaceManager *m,AddrSpace *uspace,uintm ubase)
-  : searchvn(0,Address(Address::m_minimal),(Datatype *)0)
+  : indexPool(SlabPoolBase::treeNodeSize(sizeof(Varnode *)),512), loc_tree(VarnodeCompareLocDef(),SlabAllocator<Varnode *>(&indexPool)),
+    def_tree(VarnodeCompareDefLoc(),SlabAllocator<Varnode *>(&indexPool)),
+    searchvn(0,Address(Address::m_minimal),(Datatype *)0)
 
 {
   manage = m;
@@ -857,10 +859,11 @@ void VarnodeBank::clear(void)
   VarnodeLocSet::iterator iter;
 
   for(iter=loc_tree.begin();iter!=loc_tree.end();++iter)
-    delete *iter;
+    (*iter)->~Varnode();
 
-  loc_tree.clear();
+  loc_tree.clear();		// Tree nodes go back on the free list of indexPool
   def_tree.clear();
+  varnodePool.release();	// Release all Varnode memory at once
   uniqid = uniqbase;		// Reset counter to base value
   create_index = 0;		// Reset varnode creation index
 }
@@ -874,7 +877,7 @@ void VarnodeBank::clear(void)
 Varnode *VarnodeBank::create(int4 s,const Address &m,Datatype *ct)
 
 {
-  Varnode *vn = new Varnode(s,m,ct);
+  Varnode *vn = new(varnodePool.allocate()) Varnode(s,m,ct);
   
   vn->create_index = create_index++;
   vn->lociter = loc_tree.insert(vn).first; // Frees can always be inserted without duplication
@@ -905,7 +908,7 @@ void VarnodeBank::destroy(Varnode *vn)
 
   loc_tree.erase(vn->lociter);
   def_tree.erase(vn->defiter);
-  delete vn;
+  freeVarnode(vn);
 }
 
 /// Enter the Varnode into both the \e location and \e definition based trees.
@@ -922,7 +925,7 @@ Varnode *VarnodeBank::xref(Varnode *vn)
   if (!check.second) {		// Set already contains this varnode
     othervn = *(check.first);
     replace(vn,othervn); // Patch ops using the old varnode
-    delete vn;
+    freeVarnode(vn);
     return othervn;
   }
 				// Otherwise a new insertion
@@ -1035,7 +1038,7 @@ Varnode *VarnodeBank::setDef(Varnode *vn,PcodeOp *op)
 Varnode *VarnodeBank::createDef(int4 s,const Address &m, Datatype *ct,PcodeOp *op)
 
 {
-  Varnode *vn = new Varnode(s,m,ct);
+  Varnode *vn = new(varnodePool.allocate()) Varnode(s,m,ct);
   vn->create_index = create_index++;
   vn->setDef(op);
   return xref(vn);
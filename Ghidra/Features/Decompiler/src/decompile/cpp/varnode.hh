@@ -20,6 +20,7 @@
 
 #include "pcoderaw.hh"
 #include "cover.hh"
+#include "slabpool.hh"
 
 class HighVariable;
 
@@ -41,10 +42,10 @@ struct VarnodeCompareDefLoc {
 };
 
 /// A set of Varnodes sorted by location (then by definition)
-typedef set<Varnode *,VarnodeCompareLocDef> VarnodeLocSet;
+typedef set<Varnode *,VarnodeCompareLocDef,SlabAllocator<Varnode *> > VarnodeLocSet;
 
 /// A set of Varnodes sorted by definition (then location)
-typedef set<Varnode *,VarnodeCompareDefLoc> VarnodeDefSet;
+typedef set<Varnode *,VarnodeCompareDefLoc,SlabAllocator<Varnode *> > VarnodeDefSet;
 
 /// \brief A low-level variable or contiguous set of bytes described by an Address and a size
 ///
@@ -329,10 +330,13 @@ class VarnodeBank {
   uintm uniqbase;		///< Base for unique addresses
   uintm uniqid;			///< Counter for generating unique offsets
   uint4 create_index;		///< Number of varnodes created
+  SlabPoolBase indexPool;	///< Memory for the nodes of \b loc_tree and \b def_tree (must be declared before them)
   VarnodeLocSet loc_tree;	///< Varnodes sorted by location then def
   VarnodeDefSet def_tree;	///< Varnodes sorted by def then location
   mutable Varnode searchvn;	///< Template varnode for searching trees
+  SlabPool<Varnode> varnodePool;	///< Memory for the Varnodes owned by \b this
   Varnode *xref(Varnode *vn);	///< Insert a Varnode into the sorted lists
+  void freeVarnode(Varnode *vn) { vn->~Varnode(); varnodePool.recycle(vn); }	///< Destroy a Varnode and recycle its memory
 public:
   VarnodeBank(AddrSpaceManager *m,AddrSpace *uspace,uintm ubase);	///< Construct the container
   void clear(void);						///< Clear out all Varnodes and reset counters
@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cstdlib>
 
 using namespace std;
 
@@ -260,10 +261,19 @@ public:
   /// \return the in-memory DOM tree
   Document *parseDocument(istream &s);
 
+  /// \brief Parse an XML document held in memory
+  ///
+  /// The document is parsed directly out of the string and stored.
+  /// \param str is the string holding the document text
+  /// \return the in-memory DOM tree
+  Document *parseDocument(const string &str);
+
   /// \brief Open and parse an XML file
   ///
   /// The given filename is opened on the local filesystem and an attempt is made to parse
-  /// its contents into an in-memory DOM tree. An XmlException is thrown for any parsing error.
+  /// its contents into an in-memory DOM tree. A file starting with the magic byte of the
+  /// \e packed encoding is decoded as a packed message instead of parsed as XML text.
+  /// An XmlException is thrown for any parsing error.
   /// \param filename is the name of the XML document file
   /// \return the in-memory DOM tree
   Document *openDocument(const string &filename);
@@ -299,6 +309,16 @@ struct XmlError {
 /// \return 0 if there is no error during parsing or a (non-zero) error condition
 extern int4 xml_parse(istream &i,ContentHandler *hand,int4 dbg=0);
 
+/// \brief Start-up the XML parser given an in-memory buffer and a handler
+///
+/// The buffer is scanned in place, without going through a stream.  Parsing stops at the
+/// end of the buffer or at the first null character.
+/// \param buf is the start of the character data
+/// \param len is the number of bytes in the buffer
+/// \param hand is the ContentHandler that stores or processes the XML content events
+/// \return 0 if there is no error during parsing or a (non-zero) error condition
+extern int4 xml_parse(const char *buf,int4 len,ContentHandler *hand);
+
 /// \brief Parse the given XML stream into an in-memory document
 ///
 /// The stream is parsed using the standard ContentHandler for producing an in-memory
@@ -307,6 +327,12 @@ extern int4 xml_parse(istream &i,ContentHandler *hand,int4 dbg=0);
 /// \return the in-memory XML document
 extern Document *xml_tree(istream &i);
 
+/// \brief Parse the given XML string into an in-memory document
+///
+/// \param str is the string holding the document text
+/// \return the in-memory XML document
+extern Document *xml_tree(const string &str);
+
 /// \brief Send the given character array to a stream, escaping characters with special XML meaning
 ///
 /// This makes the following character substitutions:
@@ -389,4 +415,19 @@ inline bool xml_readbool(const string &attr)
   if (firstc=='y') return true;         // For backward compatibility
   return false;
 }
+
+/// \brief Read an XML attribute value as an integer
+///
+/// The base is determined by the prefix, as with an \e istringstream whose base flags
+/// have been cleared: "0x" for hexadecimal, a leading "0" for octal, otherwise decimal.
+/// A leading minus sign is allowed, and the value wraps as for an unsigned type, so
+/// assigning the result to a signed variable recovers the negative value.  This is much
+/// cheaper than constructing a stream, which matters when restoring large documents.
+/// \param attr is the given XML attribute value (as a string)
+/// \return the integer value
+inline uintb xml_readnumber(const string &attr)
+
+{
+  return (uintb)strtoull(attr.c_str(),(char **)0,0);
+}
 #endif
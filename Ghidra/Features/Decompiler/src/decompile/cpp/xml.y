@@ -15,6 +15,7 @@
  */
 %{
 #include "xml.hh"
+#include "packedxml.hh"
 // CharData mode   look for '<' '&' or "]]>"
 // Name mode       look for non-name char
 // CData mode      looking for "]]>"
@@ -50,24 +51,44 @@ public:
 	       CommandBraceToken = 266 };
 private:
   mode curmode;			///< The current scanning mode
-  istream &s;			///< The stream being scanned
+  istream *s;			///< The stream being scanned (if not scanning a buffer)
+  const char *buf;		///< Current position in the in-memory buffer being scanned
+  const char *bufend;		///< End of the in-memory buffer being scanned
   string *lvalue;		///< Current string being built
   int4 lookahead[4];	///< Lookahead into the byte stream
   int4 pos;				///< Current position in the lookahead buffer
   bool endofstream;		///< Has end of stream been reached
   void clearlvalue(void);	///< Clear the current token string
 
+  /// \brief Read the next raw byte from the underlying buffer or stream
+  ///
+  /// \param c will hold the byte read
+  /// \return \b false if the input is exhausted
+  bool readbyte(char &c) {
+    if (buf != (const char *)0) {
+      if (buf == bufend) return false;
+      c = *buf++;
+      return true;
+    }
+    int4 val = s->rdbuf()->sbumpc();	// Bypass the istream sentry for each character
+    if (val == char_traits<char>::eof()) {
+      s->setstate(ios::eofbit);
+      return false;
+    }
+    c = (char)val;
+    return true;
+  }
+
   /// \brief Get the next byte in the stream
   ///
   /// Maintain a lookahead of 4 bytes at all times so that we can check for special
   /// XML character sequences without consuming.
   /// \return the next byte value as an integer
   int4 getxmlchar(void) {
-    char c;	    
     int4 ret=lookahead[pos];
     if (!endofstream) {
-      s.get(c); 
-      if (s.eof()||(c=='\0')) {
+      char c;
+      if (!readbyte(c)||(c=='\0')) {
 	endofstream = true;
 	lookahead[pos] = '\n';
       }
@@ -94,6 +115,7 @@ private:
   int4 scanSName(void);					///< Scan Name, allow white space before
 public:
   XmlScan(istream &t);					///< Construct scanner given a stream
+  XmlScan(const char *b,int4 len);			///< Construct scanner given an in-memory buffer
   ~XmlScan(void);						///< Destructor
   void setmode(mode m) { curmode = m; }	///< Set the scanning mode
   int4 nexttoken(void);					///< Get the next token
@@ -106,16 +128,18 @@ struct NameValue {
   string *value;	///< The value
 };
 
-extern int yylex(void);							///< Interface to the scanner
-extern int yyerror(const char *str);			///< Interface for registering an error in parsing
-extern void print_content(const string &str);	///< Send character data to the ContentHandler
+extern int yyerror(XmlScan *scan,ContentHandler *handler,const char *str);	///< Interface for registering an error in parsing
+extern void print_content(ContentHandler *handler,const string &str);	///< Send character data to the ContentHandler
 extern int4 convertEntityRef(const string &ref);	///< Convert an XML entity to its equivalent character
 extern int4 convertCharRef(const string &ref);	///< Convert an XML character reference to its equivalent character
-static XmlScan *global_scan;					///< Global reference to the scanner
-static ContentHandler *handler;					///< Global reference to the content handler
 extern int yydebug;								///< Debug mode
 %}
 
+%define api.pure
+%parse-param { XmlScan *scan }
+%parse-param { ContentHandler *handler }
+%lex-param { XmlScan *scan }
+
 %union {
   int4 i;
   string *str;
@@ -123,6 +147,10 @@ extern int yydebug;								///< Debug mode
   NameValue *pair;
 }
 
+%{
+extern int yylex(YYSTYPE *lvalp,XmlScan *scan);	///< Interface to the scanner
+%}
+
 %expect 8
 
 %token <str> CHARDATA CDATA ATTVALUE COMMENT CHARREF NAME SNAME ELEMBRACE COMMBRACE
@@ -141,20 +169,20 @@ whitespace: ' '
 S: whitespace
    | S whitespace ;
 
-attsinglemid: '\'' { $$ = new string; global_scan->setmode(XmlScan::AttValueSingleMode); }
-	      | attsinglemid ATTVALUE { $$ = $1; *$$ += *$2; delete $2; global_scan->setmode(XmlScan::AttValueSingleMode); }
-	      | attsinglemid Reference { $$ = $1; *$$ += $2; global_scan->setmode(XmlScan::AttValueSingleMode); };
-attdoublemid: '"' { $$ = new string; global_scan->setmode(XmlScan::AttValueDoubleMode); }
-	      | attdoublemid ATTVALUE { $$ = $1; *$$ += *$2; delete $2; global_scan->setmode(XmlScan::AttValueDoubleMode); }
-	      | attdoublemid Reference { $$ = $1; *$$ += $2; global_scan->setmode(XmlScan::AttValueDoubleMode); };
+attsinglemid: '\'' { $$ = new string; scan->setmode(XmlScan::AttValueSingleMode); }
+	      | attsinglemid ATTVALUE { $$ = $1; *$$ += *$2; delete $2; scan->setmode(XmlScan::AttValueSingleMode); }
+	      | attsinglemid Reference { $$ = $1; *$$ += $2; scan->setmode(XmlScan::AttValueSingleMode); };
+attdoublemid: '"' { $$ = new string; scan->setmode(XmlScan::AttValueDoubleMode); }
+	      | attdoublemid ATTVALUE { $$ = $1; *$$ += *$2; delete $2; scan->setmode(XmlScan::AttValueDoubleMode); }
+	      | attdoublemid Reference { $$ = $1; *$$ += $2; scan->setmode(XmlScan::AttValueDoubleMode); };
 AttValue: attsinglemid '\'' { $$ = $1; }
 	  | attdoublemid '"' { $$ = $1; };
-elemstart: ELEMBRACE { global_scan->setmode(XmlScan::NameMode); delete $1; };
-commentstart: COMMBRACE '!' '-' '-' { global_scan->setmode(XmlScan::CommentMode); delete $1; } ;
+elemstart: ELEMBRACE { scan->setmode(XmlScan::NameMode); delete $1; };
+commentstart: COMMBRACE '!' '-' '-' { scan->setmode(XmlScan::CommentMode); delete $1; } ;
 Comment: commentstart COMMENT '-' '-' '>' { delete $2; } ;
-PI: COMMBRACE '?' { delete $1; yyerror("Processing instructions are not supported"); YYERROR; };
+PI: COMMBRACE '?' { delete $1; yyerror(scan,handler,"Processing instructions are not supported"); YYERROR; };
 CDSect: CDStart CDATA CDEnd { $$ = $2; } ;
-CDStart: COMMBRACE '!' '[' 'C' 'D' 'A' 'T' 'A' '[' { global_scan->setmode(XmlScan::CDataMode); delete $1; } ;
+CDStart: COMMBRACE '!' '[' 'C' 'D' 'A' 'T' 'A' '[' { scan->setmode(XmlScan::CDataMode); delete $1; } ;
 CDEnd: ']' ']' '>' ;
 
 doctypepro: doctypedecl
@@ -165,7 +193,7 @@ prologpre: XMLDecl
 prolog: prologpre doctypepro
 	| prologpre ;
 
-doctypedecl: COMMBRACE '!' 'D' 'O' 'C' 'T' 'Y' 'P' 'E' { delete $1; yyerror("DTD's not supported"); YYERROR; };
+doctypedecl: COMMBRACE '!' 'D' 'O' 'C' 'T' 'Y' 'P' 'E' { delete $1; yyerror(scan,handler,"DTD's not supported"); YYERROR; };
 Eq: '='
     | S '='
     | Eq S ;
@@ -189,33 +217,53 @@ STag: stagstart '>' { handler->startElement($1->getelemURI(),$1->getelemName(),$
 EmptyElemTag: stagstart '/' '>' { handler->startElement($1->getelemURI(),$1->getelemName(),$1->getelemName(),*$1); $$ = $1; }
 	      | stagstart S '/' '>' { handler->startElement($1->getelemURI(),$1->getelemName(),$1->getelemName(),*$1); $$ = $1; };
 
-stagstart: elemstart NAME { $$ = new Attributes($2); global_scan->setmode(XmlScan::SNameMode); }
-	   | stagstart SAttribute { $$ = $1; $$->add_attribute( $2->name, $2->value); delete $2; global_scan->setmode(XmlScan::SNameMode); };
+stagstart: elemstart NAME { $$ = new Attributes($2); scan->setmode(XmlScan::SNameMode); }
+	   | stagstart SAttribute { $$ = $1; $$->add_attribute( $2->name, $2->value); delete $2; scan->setmode(XmlScan::SNameMode); };
 SAttribute: SNAME Eq AttValue { $$ = new NameValue; $$->name = $1; $$->value = $3; };
-etagbrace: COMMBRACE '/' { global_scan->setmode(XmlScan::NameMode); delete $1; };
+etagbrace: COMMBRACE '/' { scan->setmode(XmlScan::NameMode); delete $1; };
 ETag: etagbrace NAME '>' { $$ = $2; }
       | etagbrace NAME S '>' { $$ = $2; };
 
-content: { global_scan->setmode(XmlScan::CharDataMode); }
-	 | content CHARDATA { print_content( *$2 ); delete $2; global_scan->setmode(XmlScan::CharDataMode); }
-	 | content element { global_scan->setmode(XmlScan::CharDataMode); }
-	 | content Reference { string *tmp=new string(); *tmp += $2; print_content(*tmp); delete tmp; global_scan->setmode(XmlScan::CharDataMode); }
-	 | content CDSect { print_content( *$2 ); delete $2; global_scan->setmode(XmlScan::CharDataMode); }
-	 | content PI { global_scan->setmode(XmlScan::CharDataMode); }
-	 | content Comment { global_scan->setmode(XmlScan::CharDataMode); };
+content: { scan->setmode(XmlScan::CharDataMode); }
+	 | content CHARDATA { print_content(handler, *$2 ); delete $2; scan->setmode(XmlScan::CharDataMode); }
+	 | content element { scan->setmode(XmlScan::CharDataMode); }
+	 | content Reference { string *tmp=new string(); *tmp += $2; print_content(handler,*tmp); delete tmp; scan->setmode(XmlScan::CharDataMode); }
+	 | content CDSect { print_content(handler, *$2 ); delete $2; scan->setmode(XmlScan::CharDataMode); }
+	 | content PI { scan->setmode(XmlScan::CharDataMode); }
+	 | content Comment { scan->setmode(XmlScan::CharDataMode); };
 
 Reference: EntityRef { $$ = convertEntityRef(*$1); delete $1; }
 	   | CharRef { $$ = convertCharRef(*$1); delete $1; };
 
-refstart: '&' { global_scan->setmode(XmlScan::NameMode); } ;
-charrefstart: refstart '#' { global_scan->setmode(XmlScan::CharRefMode); };
+refstart: '&' { scan->setmode(XmlScan::NameMode); } ;
+charrefstart: refstart '#' { scan->setmode(XmlScan::CharRefMode); };
 CharRef: charrefstart CHARREF ';' { $$ = $2; };
 EntityRef: refstart NAME ';' { $$ = $2; };
 %%
 
-XmlScan::XmlScan(istream &t) : s(t)
+XmlScan::XmlScan(istream &t)
 
 {
+  s = &t;
+  buf = (const char *)0;
+  bufend = (const char *)0;
+  curmode = SingleMode;
+  lvalue = (string *)0;
+  pos = 0;
+  endofstream = false;
+  getxmlchar(); getxmlchar(); getxmlchar(); getxmlchar(); // Fill lookahead buffer
+}
+
+/// The buffer is scanned in place and must remain valid for the life of the scanner.
+/// Scanning stops at the end of the buffer or at the first null character.
+/// \param b is the start of the buffer
+/// \param len is the number of bytes in the buffer
+XmlScan::XmlScan(const char *b,int4 len)
+
+{
+  s = (istream *)0;
+  buf = b;
+  bufend = b + len;
   curmode = SingleMode;
   lvalue = (string *)0;
   pos = 0;
@@ -442,7 +490,7 @@ int4 XmlScan::nexttoken(void)
   return -1;
 }
 
-void print_content(const string &str)
+void print_content(ContentHandler *handler,const string &str)
 
 {
   uint4 i;
@@ -495,36 +543,53 @@ int4 convertCharRef(const string &ref)
   return val;
 }
 
-int yylex(void)
+int yylex(YYSTYPE *lvalp,XmlScan *scan)
 
 {
-  int res = global_scan->nexttoken();
+  int res = scan->nexttoken();
   if (res>255)
-    yylval.str = global_scan->lval();
+    lvalp->str = scan->lval();
   return res;
 }
 
-int yyerror(const char *str)
+int yyerror(XmlScan *scan,ContentHandler *handler,const char *str)
 
 {
   handler->setError(str);
   return 0;
 }
 
+/// \brief Run the parser over an initialized scanner
+///
+/// All parser state is local to this call, so separate documents can be parsed concurrently.
+/// \param scan is the scanner attached to the input
+/// \param hand is the ContentHandler receiving the parse events
+/// \return 0 if there is no error during parsing or a (non-zero) error condition
+static int4 xml_parse_scan(XmlScan &scan,ContentHandler *hand)
+
+{
+  hand->startDocument();
+  int4 res = yyparse(&scan,hand);
+  if (res == 0)
+    hand->endDocument();
+  return res;
+}
+
 int4 xml_parse(istream &i,ContentHandler *hand,int4 dbg)
 
 {
 #if YYDEBUG
   yydebug = dbg;
 #endif
-  global_scan = new XmlScan(i);
-  handler = hand;
-  handler->startDocument();
-  int4 res = yyparse();
-  if (res == 0)
-    handler->endDocument();
-  delete global_scan;
-  return res;
+  XmlScan scan(i);
+  return xml_parse_scan(scan,hand);
+}
+
+int4 xml_parse(const char *buf,int4 len,ContentHandler *hand)
+
+{
+  XmlScan scan(buf,len);
+  return xml_parse_scan(scan,hand);
 }
 
 void TreeHandler::startElement(const string &namespaceURI,const string &localName,
@@ -585,15 +650,38 @@ Document *DocumentStorage::parseDocument(istream &s)
   return doclist.back();
 }
 
+Document *DocumentStorage::parseDocument(const string &str)
+
+{
+  doclist.push_back((Document *)0);
+  doclist.back() = xml_tree(str);
+  return doclist.back();
+}
+
 Document *DocumentStorage::openDocument(const string &filename)
 
 {
   ifstream s(filename.c_str());
   if (!s)
     throw XmlError("Unable to open xml document "+filename);
-  Document *res = parseDocument(s);
+  if (s.peek() == PackedXmlWriter::magic) {	// Binary image written in the packed encoding
+    s.close();
+    doclist.push_back((Document *)0);
+    doclist.back() = packed_file(filename);
+    return doclist.back();
+  }
+  // Read the whole file at once and scan it in memory, rather than a character at a time from the stream
+  string buf;
+  s.seekg(0,ios::end);
+  streamoff size = s.tellg();
+  s.seekg(0,ios::beg);
+  if (size > 0) {
+    buf.resize(size);
+    s.read(&buf[0],size);
+    buf.resize(s.gcount());	// Fewer characters if line endings were translated
+  }
   s.close();
-  return res;
+  return parseDocument(buf);
 }
 
 void DocumentStorage::registerTag(const Element *el)
@@ -625,6 +713,18 @@ Document *xml_tree(istream &i)
   return doc;
 }
 
+Document *xml_tree(const string &str)
+
+{
+  Document *doc = new Document();
+  TreeHandler handle(doc);
+  if (0!=xml_parse(str.c_str(),str.size(),&handle)) {
+    delete doc;
+    throw XmlError(handle.getError());
+  }
+  return doc;
+}
+
 void xml_escape(ostream &s,const char *str)
 
 {
@@ -737,6 +737,25 @@ public class DecompileCallback {
 		return null;
 	}
 
+	/**
+	 * Called by the native decompiler to query the GHIDRA database about any
+	 * symbols at many addresses at once, in a single round trip.
+	 * 
+	 * @param addrstrings XML encoded addresses to query
+	 * @return a batch tag holding, in order, the result of getMappedSymbolsXML for each
+	 *         address, or an empty none tag where there was no result
+	 */
+	public String getMappedSymbolsBatchXML(String[] addrstrings) {
+		StringBuilder buf = new StringBuilder();
+		buf.append("<batch>\n");
+		for (String addrstring : addrstrings) {
+			String res = getMappedSymbolsXML(addrstring);
+			buf.append((res != null) ? res : "<none/>\n");
+		}
+		buf.append("</batch>\n");
+		return buf.toString();
+	}
+
 	public String getExternalRefXML(String addrstring) { // Return any external reference at addr
 		Address addr;
 		try {
@@ -26,6 +26,7 @@ import ghidra.program.model.lang.PackedBytes;
 import ghidra.util.Msg;
 import ghidra.util.timer.GTimer;
 import ghidra.util.timer.GTimerMonitor;
+import ghidra.xml.PackedXmlEncoder;
 
 /**
  * 
@@ -57,6 +58,9 @@ public class DecompileProcess {
 
 	//private static final int MAXIMUM_RESULT_SIZE = 50 * 1024 * 1024; // maximum result size in bytes to allow from decompiler
 
+	// Set this property to keep all documents exchanged with the decompiler as XML text
+	private static final boolean XML_PROTOCOL_ONLY = Boolean.getBoolean("decompiler.xml.protocol");
+
 	private Runtime runtime = Runtime.getRuntime();
 	private String[] exepath; // Path to the decompiler executable
 	private Runnable timeoutRunnable;
@@ -68,6 +72,7 @@ public class DecompileProcess {
 	private volatile boolean statusGood;     // true if decompiler process is running
 
 	private int archId = -1;              // architecture id for decomp process
+	private boolean packedDocuments;      // true if documents are exchanged in the packed encoding
 	private DecompileCallback callback;   // Callback interface for decompiler
 	private int maxResultSizeMBYtes = 50; // maximum result size in MBytes to allow from decompiler
 
@@ -236,6 +241,22 @@ public class DecompileProcess {
 		write(string_end);
 	}
 
+	/**
+	 * Send an XML document to the decompiler, in the packed encoding if it was negotiated
+	 * when the program was registered
+	 * @param xml is the XML document text
+	 * @throws IOException for any problems with the output stream
+	 */
+	private void writeDocument(String xml) throws IOException {
+		if (!packedDocuments) {
+			writeString(xml);
+			return;
+		}
+		write(string_start);
+		write(PackedXmlEncoder.encode(xml));
+		write(string_end);
+	}
+
 	/**
 	 * Transfer bytes written to -out- to decompiler process
 	 * @param out has the collected byte for this write
@@ -314,7 +335,12 @@ public class DecompileProcess {
 								getExternalRefXML();			// getExternalRefXML
 								break;
 							case 'M':
-								getMappedSymbolsXML();			// getMappedSymbolsXML
+								if (name.equals("getMappedSymbolsBatchXML")) {
+									getMappedSymbolsBatchXML();
+								}
+								else {
+									getMappedSymbolsXML();		// getMappedSymbolsXML
+								}
 								break;
 							case 'N':
 								getNamespacePath();
@@ -427,7 +453,9 @@ public class DecompileProcess {
 	// Calls to the decompiler
 
 	/**
-	 * Initialize decompiler for a particular platform
+	 * Initialize decompiler for a particular platform.  The client offers batched symbol
+	 * queries and query statistics, and the packed encoding for documents unless the
+	 * decompiler.xml.protocol property is set.  Each is used only if the decompiler accepts it.
 	 * @param cback = callback object for decompiler
 	 * @param pspecxml = string containing .pspec xml
 	 * @param cspecxml = string containing .cspec xml
@@ -450,6 +478,7 @@ public class DecompileProcess {
 			writeString(cspecxml);
 			writeString(tspecxml);
 			writeString(coretypesxml);
+			writeString((XML_PROTOCOL_ONLY ? "xml" : "packed") + " batch stats");
 			write(command_end);
 			restring = readResponse().toString();
 		}
@@ -457,7 +486,15 @@ public class DecompileProcess {
 			statusGood = false;
 			throw e;
 		}
-		archId = Integer.parseInt(restring);
+		// The id is followed by the name of each accepted capability
+		String[] fields = restring.split(" ");
+		archId = Integer.parseInt(fields[0]);
+		packedDocuments = false;
+		for (int i = 1; i < fields.length; ++i) {
+			if (fields[i].equals("packed")) {
+				packedDocuments = true;
+			}
+		}
 	}
 
 	/**
@@ -706,7 +743,22 @@ public class DecompileProcess {
 		String res = callback.getMappedSymbolsXML(addr);
 		write(query_response_start);
 		if ((res != null) && (res.length() != 0)) {
-			writeString(res);
+			writeDocument(res);
+		}
+		write(query_response_end);
+	}
+
+	private void getMappedSymbolsBatchXML() throws IOException {
+		int num = Integer.parseInt(readQueryString());
+		String[] addrs = new String[num];
+		for (int i = 0; i < num; ++i) {
+			addrs[i] = readQueryString();
+		}
+
+		String res = callback.getMappedSymbolsBatchXML(addrs);
+		write(query_response_start);
+		if ((res != null) && (res.length() != 0)) {
+			writeDocument(res);
 		}
 		write(query_response_end);
 	}
@@ -21,6 +21,7 @@ import ghidra.program.model.lang.CompilerSpec;
 import ghidra.program.model.lang.Language;
 import ghidra.program.model.listing.Function;
 import ghidra.program.model.pcode.*;
+import ghidra.util.xml.SpecXmlUtils;
 import ghidra.xml.XmlElement;
 import ghidra.xml.XmlPullParser;
 
@@ -61,6 +62,9 @@ public class DecompileResults {
 	private HighParamID hparamid; //Parameter ID information
 	private ClangTokenGroup docroot; // C code parsed from XML
 	private String errMsg; // Error message from decompiler
+	private int numQueries; // Queries the decompiler sent back to Ghidra, or -1 if not reported
+	private int numSymbolQueries; // Single address symbol queries, or -1 if not reported
+	private int numBatchedAddresses; // Addresses fetched in batched symbol queries, or -1
 	private DecompileProcess.DisposeState processState;
 
 	public DecompileResults(Function f, Language language, CompilerSpec compilerSpec,
@@ -74,6 +78,9 @@ public class DecompileResults {
 		hfunc = null;
 		hparamid = null;
 		docroot = null;
+		numQueries = -1;
+		numSymbolQueries = -1;
+		numBatchedAddresses = -1;
 		//dumpResults(raw);
 		parseRawString(raw);
 	}
@@ -188,6 +195,33 @@ public class DecompileResults {
 		return docroot;
 	}
 
+	/**
+	 * Get the number of queries the decompiler sent back to Ghidra while producing
+	 * these results.  This counts every round trip, including the symbol queries.
+	 * @return the number of queries, or -1 if the decompiler did not report it
+	 */
+	public int getQueryCount() {
+		return numQueries;
+	}
+
+	/**
+	 * Get the number of single address symbol queries the decompiler sent while producing
+	 * these results
+	 * @return the number of queries, or -1 if the decompiler did not report it
+	 */
+	public int getSymbolQueryCount() {
+		return numSymbolQueries;
+	}
+
+	/**
+	 * Get the number of addresses whose symbols were fetched in batched queries while
+	 * producing these results
+	 * @return the number of addresses, or -1 if the decompiler did not report it
+	 */
+	public int getBatchedAddressCount() {
+		return numBatchedAddresses;
+	}
+
 	/**
 	 * Converts the C code results into an unadorned string.
 	 * The returned object contains both the whole function
@@ -237,6 +271,13 @@ public class DecompileResults {
 						hparamid = new HighParamID(function, language, compilerSpec, dtmanage);
 						hparamid.readXML(parser);
 					}
+					else if (el.getName().equals("querystats")) {
+						el = parser.start("querystats");
+						numQueries = SpecXmlUtils.decodeInt(el.getAttribute("queries"));
+						numSymbolQueries = SpecXmlUtils.decodeInt(el.getAttribute("symbolqueries"));
+						numBatchedAddresses = SpecXmlUtils.decodeInt(el.getAttribute("batchaddrs"));
+						parser.end(el);
+					}
 					else {
 						errMsg = "Unknown decompiler tag: "+el.getName();
 						return;
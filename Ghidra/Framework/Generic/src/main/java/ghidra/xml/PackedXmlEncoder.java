@@ -0,0 +1,433 @@
+/* ###
+ * IP: GHIDRA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package ghidra.xml;
+
+import java.io.ByteArrayOutputStream;
+import java.nio.charset.StandardCharsets;
+import java.util.HashMap;
+
+/**
+ * Writer for the <i>packed</i> encoding of an XML document, used to send documents to and from
+ * the decompiler process in place of XML text.
+ * <p>
+ * The packed encoding carries the same tree as the XML text: element starts and ends,
+ * attributes, and character content.  Element and attribute names, and attribute values that
+ * are not integers, are written into a string table the first time they are seen and referred
+ * to by index afterward.  Values that are integers in canonical form ("0x" followed by lower case
+ * hex digits, or decimal, with no leading zeros) are written as variable length integers and
+ * rendered back in exactly the same form when decoded. The table lives for a single message.
+ * <p>
+ * No byte of the encoding is zero, so a packed message can be sent as the body of a string in
+ * the decompiler protocol.  A message starts with the {@link #MAGIC} byte, which can never start
+ * an XML document, so a reader can tell the two encodings apart from the first byte.
+ * <p>
+ * A variable length integer is sent 6 bits per byte, least significant bits first.  Each byte
+ * has bit 7 set and has bit 6 set if more bytes follow.
+ * <p>
+ * This must match the encoding in the decompiler's packedxml.cc.
+ */
+public class PackedXmlEncoder {
+	public static final int MAGIC = 0x7f;			// First byte of a packed message
+	public static final int VERSION = 0x01;			// Second byte of a packed message
+	public static final int ELEM_START = 0x02;		// Start of an element, followed by its name
+	public static final int ELEM_END = 0x03;		// End of the current element
+	public static final int ATTRIBUTE = 0x04;		// Attribute, followed by a name and a value
+	public static final int CONTENT = 0x05;			// Character content, followed by a value
+	public static final int VALUE_STRING = 0x10;	// Value is a string
+	public static final int VALUE_HEX = 0x11;		// Value is an unsigned integer in "0x" hex
+	public static final int VALUE_DEC = 0x12;		// Value is an unsigned integer in decimal
+	public static final int VALUE_NEGDEC = 0x13;	// Value is a negative integer in decimal
+	public static final int STRING_REF = 0x20;		// String is the table entry with the following index
+	public static final int STRING_DEFINE = 0x21;	// String follows and is the next table entry
+	public static final int STRING_LITERAL = 0x22;	// String follows and is not put in the table
+
+	private static final int MAX_TABLE_STRING = 64;	// Longer content is sent as a literal
+
+	private ByteArrayOutputStream out;
+	private HashMap<String, Integer> table = new HashMap<>();
+	private int depth = 0;
+	private long parsedValue;		// Integer from the last successful parseHex or parseDecimal
+
+	/**
+	 * Start a new packed message
+	 * @param initialSize is a hint for the size of the message in bytes
+	 */
+	public PackedXmlEncoder(int initialSize) {
+		out = new ByteArrayOutputStream(initialSize);
+		out.write(MAGIC);
+		out.write(VERSION);
+	}
+
+	/**
+	 * @return the bytes of the message written so far
+	 */
+	public byte[] toByteArray() {
+		return out.toByteArray();
+	}
+
+	/**
+	 * Transcode the given XML document text into a packed message
+	 * @param xml is the XML document text
+	 * @return the packed message
+	 * @throws XmlException if the text is not well formed
+	 */
+	public static byte[] encode(String xml) {
+		PackedXmlEncoder encoder = new PackedXmlEncoder(xml.length() / 2 + 16);
+		encoder.transcode(xml);
+		return encoder.toByteArray();
+	}
+
+	/**
+	 * Test if the given bytes start with a packed message
+	 * @param buf is the buffer
+	 * @param len is the number of bytes in the buffer
+	 * @return true if the buffer holds a packed message
+	 */
+	public static boolean isEncoded(byte[] buf, int len) {
+		return len > 0 && (buf[0] & 0xff) == MAGIC;
+	}
+
+	private void writeVarint(long val) {
+		for (;;) {
+			int b = 0x80 | (int) (val & 0x3f);
+			val >>>= 6;
+			if (val == 0) {
+				out.write(b);
+				return;
+			}
+			out.write(b | 0x40);
+		}
+	}
+
+	private void writeRaw(int tok, String str) {
+		byte[] bytes = str.getBytes(StandardCharsets.UTF_8);
+		out.write(tok);
+		writeVarint(bytes.length);
+		out.write(bytes, 0, bytes.length);
+	}
+
+	private void writeString(String str) {
+		Integer index = table.get(str);
+		if (index != null) {
+			out.write(STRING_REF);
+			writeVarint(index);
+			return;
+		}
+		table.put(str, table.size());
+		writeRaw(STRING_DEFINE, str);
+	}
+
+	private void writeValue(String val) {
+		if (parseHex(val)) {
+			out.write(VALUE_HEX);
+			writeVarint(parsedValue);
+			return;
+		}
+		if (parseDecimal(val, 0)) {
+			out.write(VALUE_DEC);
+			writeVarint(parsedValue);
+			return;
+		}
+		if (val.length() > 1 && val.charAt(0) == '-' && parseDecimal(val, 1)) {
+			out.write(VALUE_NEGDEC);
+			writeVarint(parsedValue);
+			return;
+		}
+		out.write(VALUE_STRING);
+		if (val.length() > MAX_TABLE_STRING) {
+			writeRaw(STRING_LITERAL, val);
+		}
+		else {
+			writeString(val);
+		}
+	}
+
+	/**
+	 * Parse a hex integer in canonical form, up to 64 bits, into parsedValue
+	 * @param val is the attribute value
+	 * @return true if the value is in canonical form
+	 */
+	private boolean parseHex(String val) {
+		int sz = val.length();
+		if (sz < 3 || sz > 18 || val.charAt(0) != '0' || val.charAt(1) != 'x') {
+			return false;
+		}
+		if (val.charAt(2) == '0' && sz != 3) {
+			return false;
+		}
+		long res = 0;
+		for (int i = 2; i < sz; ++i) {
+			char c = val.charAt(i);
+			res <<= 4;
+			if (c >= '0' && c <= '9') {
+				res |= c - '0';
+			}
+			else if (c >= 'a' && c <= 'f') {
+				res |= c - 'a' + 10;
+			}
+			else {
+				return false;
+			}
+		}
+		parsedValue = res;
+		return true;
+	}
+
+	/**
+	 * Parse a decimal integer in canonical form into parsedValue. There must be few enough
+	 * digits that the integer cannot overflow.
+	 * @param val is the attribute value
+	 * @param start is the index of the first digit
+	 * @return true if the value is in canonical form
+	 */
+	private boolean parseDecimal(String val, int start) {
+		int sz = val.length();
+		if (sz <= start || sz - start > 18) {
+			return false;
+		}
+		if (val.charAt(start) == '0' && sz != start + 1) {
+			return false;
+		}
+		long res = 0;
+		for (int i = start; i < sz; ++i) {
+			char c = val.charAt(i);
+			if (c < '0' || c > '9') {
+				return false;
+			}
+			res = res * 10 + (c - '0');
+		}
+		parsedValue = res;
+		return true;
+	}
+
+	/**
+	 * Start a new element
+	 * @param name is the name of the element
+	 */
+	public void startElement(String name) {
+		out.write(ELEM_START);
+		writeString(name);
+		depth += 1;
+	}
+
+	/**
+	 * Add an attribute to the element just started
+	 * @param name is the name of the attribute
+	 * @param val is the (unescaped) value
+	 */
+	public void addAttribute(String name, String val) {
+		out.write(ATTRIBUTE);
+		writeString(name);
+		writeValue(val);
+	}
+
+	/**
+	 * Add character content to the current element
+	 * @param text is the (unescaped) character data
+	 */
+	public void addContent(String text) {
+		if (text.length() == 0) {
+			return;
+		}
+		out.write(CONTENT);
+		writeValue(text);
+	}
+
+	/**
+	 * End the current element
+	 */
+	public void endElement() {
+		out.write(ELEM_END);
+		depth -= 1;
+	}
+
+	private static int decodeEntity(String xml, int pos, StringBuilder res) {
+		int semi = xml.indexOf(';', pos);
+		if (semi < 0 || semi == pos + 1) {
+			throw new XmlException("Packed transcode: Bad reference");
+		}
+		String ref = xml.substring(pos + 1, semi);
+		if (ref.charAt(0) == '#') {
+			int code;
+			if (ref.length() > 1 && ref.charAt(1) == 'x') {
+				code = Integer.parseInt(ref.substring(2), 16);
+			}
+			else {
+				code = Integer.parseInt(ref.substring(1));
+			}
+			res.appendCodePoint(code);
+		}
+		else if (ref.equals("lt")) {
+			res.append('<');
+		}
+		else if (ref.equals("gt")) {
+			res.append('>');
+		}
+		else if (ref.equals("amp")) {
+			res.append('&');
+		}
+		else if (ref.equals("quot")) {
+			res.append('"');
+		}
+		else if (ref.equals("apos")) {
+			res.append('\'');
+		}
+		else {
+			throw new XmlException("Packed transcode: Unknown entity: " + ref);
+		}
+		return semi + 1;
+	}
+
+	private static int skipSpace(String xml, int pos) {
+		while (pos < xml.length() && Character.isWhitespace(xml.charAt(pos))) {
+			++pos;
+		}
+		return pos;
+	}
+
+	private static int skipPast(String xml, int pos, String term) {
+		int res = xml.indexOf(term, pos);
+		if (res < 0) {
+			throw new XmlException("Packed transcode: Unterminated markup");
+		}
+		return res + term.length();
+	}
+
+	/**
+	 * Write a document given as XML text.  The text is scanned once, without building a tree.
+	 * Only the subset of XML sent between the decompiler and its client is supported: elements,
+	 * attributes, character data and references, CDATA sections, comments, and processing
+	 * instructions, which are skipped along with any document type declaration.  Character
+	 * data between two tags is sent as one piece of content, including any whitespace.
+	 * @param xml is the XML document text
+	 * @throws XmlException if the text is not well formed
+	 */
+	public void transcode(String xml) {
+		StringBuilder text = new StringBuilder();
+		StringBuilder val = new StringBuilder();
+		int len = xml.length();
+		int pos = 0;
+		while (pos < len) {
+			char c = xml.charAt(pos);
+			if (c == '&') {
+				pos = decodeEntity(xml, pos, text);
+				continue;
+			}
+			if (c != '<') {
+				text.append(c);
+				pos += 1;
+				continue;
+			}
+			pos += 1;
+			if (pos == len) {
+				throw new XmlException("Packed transcode: Unexpected end of document");
+			}
+			c = xml.charAt(pos);
+			if (c == '?' || c == '!') {
+				if (xml.startsWith("![CDATA[", pos)) {
+					int endPos = xml.indexOf("]]>", pos + 8);
+					if (endPos < 0) {
+						throw new XmlException("Packed transcode: Unterminated CDATA");
+					}
+					text.append(xml, pos + 8, endPos);
+					pos = endPos + 3;
+				}
+				else if (xml.startsWith("!--", pos)) {
+					pos = skipPast(xml, pos, "-->");
+				}
+				else if (c == '?') {
+					pos = skipPast(xml, pos, "?>");
+				}
+				else {
+					pos = skipPast(xml, pos, ">");
+				}
+				continue;
+			}
+			if (depth > 0) {
+				addContent(text.toString());
+			}
+			text.setLength(0);
+			if (c == '/') {		// End tag
+				pos = skipPast(xml, pos, ">");
+				if (depth == 0) {
+					throw new XmlException("Packed transcode: Bad end tag");
+				}
+				endElement();
+				continue;
+			}
+			int start = pos;
+			while (pos < len && !Character.isWhitespace(xml.charAt(pos)) &&
+				xml.charAt(pos) != '/' && xml.charAt(pos) != '>') {
+				++pos;
+			}
+			if (pos == start) {
+				throw new XmlException("Packed transcode: Missing element name");
+			}
+			startElement(xml.substring(start, pos));
+			for (;;) {
+				pos = skipSpace(xml, pos);
+				if (pos == len) {
+					throw new XmlException("Packed transcode: Unterminated tag");
+				}
+				c = xml.charAt(pos);
+				if (c == '>') {
+					pos += 1;
+					break;
+				}
+				if (c == '/') {
+					if (pos + 1 == len || xml.charAt(pos + 1) != '>') {
+						throw new XmlException("Packed transcode: Bad empty element tag");
+					}
+					pos += 2;
+					endElement();
+					break;
+				}
+				start = pos;
+				while (pos < len && !Character.isWhitespace(xml.charAt(pos)) &&
+					xml.charAt(pos) != '=') {
+					++pos;
+				}
+				String name = xml.substring(start, pos);
+				pos = skipSpace(xml, pos);
+				if (pos == len || xml.charAt(pos) != '=') {
+					throw new XmlException("Packed transcode: Missing '=' after attribute " + name);
+				}
+				pos = skipSpace(xml, pos + 1);
+				if (pos == len || (xml.charAt(pos) != '"' && xml.charAt(pos) != '\'')) {
+					throw new XmlException("Packed transcode: Missing attribute quote");
+				}
+				char quote = xml.charAt(pos++);
+				val.setLength(0);
+				while (pos < len && xml.charAt(pos) != quote) {
+					if (xml.charAt(pos) == '&') {
+						pos = decodeEntity(xml, pos, val);
+					}
+					else {
+						val.append(xml.charAt(pos++));
+					}
+				}
+				if (pos == len) {
+					throw new XmlException("Packed transcode: Unterminated attribute value");
+				}
+				pos += 1;
+				addAttribute(name, val.toString());
+			}
+		}
+		if (depth != 0) {
+			throw new XmlException("Packed transcode: Unclosed elements at end of document");
+		}
+	}
+}
@@ -0,0 +1,275 @@
+/* ###
+ * IP: GHIDRA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package ghidra.xml;
+
+import static ghidra.xml.PackedXmlEncoder.*;
+
+import java.io.*;
+import java.nio.charset.StandardCharsets;
+import java.util.*;
+
+import org.xml.sax.SAXException;
+
+/**
+ * A pull parser over a document in the packed encoding written by {@link PackedXmlEncoder}
+ * or by the decompiler process.  The whole message is decoded up front, like
+ * {@link NonThreadedXmlPullParserImpl}, and produces the same elements, attributes, and text
+ * that parser produces for the equivalent XML text.  The column number of each element is
+ * its offset in the message.
+ */
+public class PackedXmlPullParser extends AbstractXmlPullParser {
+	private LinkedList<XmlElement> queue = new LinkedList<>();
+	private String name;
+
+	private byte[] buf;
+	private int pos;
+	private int end;
+	private ArrayList<String> table = new ArrayList<>();
+
+	/**
+	 * Decode the given packed message
+	 * @param buf holds the message
+	 * @param len is the number of bytes in the message
+	 * @param inputName is the name of the input for error messages
+	 * @throws SAXException if the message is badly formed
+	 */
+	public PackedXmlPullParser(byte[] buf, int len, String inputName) throws SAXException {
+		this.name = inputName;
+		this.buf = buf;
+		this.pos = 0;
+		this.end = len;
+		try {
+			fillQueue();
+		}
+		catch (XmlException e) {
+			throw new SAXException(inputName + ": " + e.getMessage());
+		}
+		this.buf = null;
+		table = null;
+	}
+
+	/**
+	 * Decode a packed message read from the given stream
+	 * @param input is the stream holding the message
+	 * @param inputName is the name of the input for error messages
+	 * @throws SAXException if the message is badly formed
+	 * @throws IOException if the stream cannot be read
+	 */
+	public PackedXmlPullParser(InputStream input, String inputName)
+			throws SAXException, IOException {
+		this(readAll(input), inputName);
+	}
+
+	private PackedXmlPullParser(ByteArrayOutputStream bytes, String inputName)
+			throws SAXException {
+		this(bytes.toByteArray(), bytes.size(), inputName);
+	}
+
+	private static ByteArrayOutputStream readAll(InputStream input) throws IOException {
+		ByteArrayOutputStream res = new ByteArrayOutputStream();
+		byte[] chunk = new byte[8192];
+		int n;
+		while ((n = input.read(chunk)) > 0) {
+			res.write(chunk, 0, n);
+		}
+		return res;
+	}
+
+	/**
+	 * Test if the given stream holds a packed message, without consuming any of it
+	 * @param input is the stream, which must support mark and reset
+	 * @return true if the first byte of the stream is the packed magic byte
+	 * @throws IOException if the stream cannot be read
+	 */
+	public static boolean isPacked(InputStream input) throws IOException {
+		input.mark(1);
+		int c = input.read();
+		input.reset();
+		return c == MAGIC;
+	}
+
+	private int readByte() {
+		if (pos >= end) {
+			throw new XmlException("Packed decode: Unexpected end of message");
+		}
+		return buf[pos++] & 0xff;
+	}
+
+	private long readVarint() {
+		long res = 0;
+		int shift = 0;
+		for (;;) {
+			int b = readByte();
+			if ((b & 0x80) == 0) {
+				throw new XmlException("Packed decode: Bad integer");
+			}
+			res |= ((long) (b & 0x3f)) << shift;
+			if ((b & 0x40) == 0) {
+				return res;
+			}
+			shift += 6;
+		}
+	}
+
+	private String readString() {
+		int tok = readByte();
+		if (tok == STRING_REF) {
+			long index = readVarint();
+			if (index >= table.size()) {
+				throw new XmlException("Packed decode: Bad string index");
+			}
+			return table.get((int) index);
+		}
+		if (tok != STRING_DEFINE && tok != STRING_LITERAL) {
+			throw new XmlException("Packed decode: Expecting string");
+		}
+		long len = readVarint();
+		if (len > end - pos) {
+			throw new XmlException("Packed decode: Unexpected end of message");
+		}
+		String res = new String(buf, pos, (int) len, StandardCharsets.UTF_8);
+		pos += len;
+		if (tok == STRING_DEFINE) {
+			table.add(res);
+		}
+		return res;
+	}
+
+	private String readValue() {
+		int tok = readByte();
+		switch (tok) {
+			case VALUE_STRING:
+				return readString();
+			case VALUE_HEX:
+				return "0x" + Long.toHexString(readVarint());
+			case VALUE_DEC:
+				return Long.toUnsignedString(readVarint());
+			case VALUE_NEGDEC:
+				return "-" + Long.toUnsignedString(readVarint());
+			default:
+				throw new XmlException("Packed decode: Bad value");
+		}
+	}
+
+	private void fillQueue() {
+		if (end < 2 || (buf[0] & 0xff) != MAGIC) {
+			throw new XmlException("Packed decode: Missing magic");
+		}
+		if ((buf[1] & 0xff) != VERSION) {
+			throw new XmlException("Packed decode: Unsupported version");
+		}
+		pos = 2;
+		ArrayDeque<String> stack = new ArrayDeque<>();
+		StringBuilder textBuf = new StringBuilder();
+		String startName = null;		// Element whose start has not been queued yet
+		LinkedHashMap<String, String> attrMap = null;
+		int startPos = 0;
+		int level = -1;
+		while (pos < end) {
+			int tokPos = pos;
+			int tok = readByte();
+			if (tok == ATTRIBUTE) {
+				if (startName == null) {
+					throw new XmlException("Packed decode: Attribute outside of start tag");
+				}
+				String attrName = readString();
+				attrMap.put(attrName, readValue());
+				continue;
+			}
+			if (startName != null) {
+				queue.add(
+					new XmlElementImpl(true, false, startName, level, attrMap, null, startPos, 1));
+				startName = null;
+			}
+			switch (tok) {
+				case ELEM_START:
+					++level;
+					startName = readString();
+					stack.push(startName);
+					attrMap = new LinkedHashMap<>();
+					startPos = tokPos;
+					// Like the SAX parser, text before a child element is dropped
+					textBuf.setLength(0);
+					break;
+				case ELEM_END:
+					if (stack.isEmpty()) {
+						throw new XmlException("Packed decode: Unbalanced element end");
+					}
+					queue.add(new XmlElementImpl(false, true, stack.pop(), level, null,
+						textBuf.toString(), tokPos, 1));
+					textBuf = new StringBuilder();
+					--level;
+					break;
+				case CONTENT:
+					textBuf.append(readValue());
+					break;
+				default:
+					throw new XmlException("Packed decode: Bad token");
+			}
+		}
+		if (startName != null || !stack.isEmpty() || queue.isEmpty()) {
+			throw new XmlException("Packed decode: Incomplete document");
+		}
+	}
+
+	@Override
+	public void dispose() {
+		// nothing to do
+	}
+
+	@Override
+	public String getName() {
+		return name;
+	}
+
+	@Override
+	public String getProcessingInstruction(String piName, String attribute) {
+		return null;
+	}
+
+	@Override
+	public boolean hasNext() {
+		return !queue.isEmpty();
+	}
+
+	@Override
+	public boolean isPullingContent() {
+		return false;
+	}
+
+	@Override
+	public XmlElement next() {
+		if (hasNext()) {
+			return queue.removeFirst();
+		}
+		return null;
+	}
+
+	@Override
+	public XmlElement peek() {
+		if (hasNext()) {
+			return queue.getFirst();
+		}
+		return null;
+	}
+
+	@Override
+	public void setPullingContent(boolean pullingContent) {
+		if (pullingContent) {
+			throw new RuntimeException("this impl can't inject content");
+		}
+	}
+}
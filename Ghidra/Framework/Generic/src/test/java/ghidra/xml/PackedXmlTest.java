@@ -0,0 +1,117 @@
+/* ###
+ * IP: GHIDRA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package ghidra.xml;
+
+import static org.junit.Assert.*;
+
+import java.io.ByteArrayInputStream;
+
+import org.junit.Test;
+
+import generic.test.AbstractGenericTest;
+
+public class PackedXmlTest extends AbstractGenericTest {
+
+	private static final String SYMBOLS_XML = "<result>\n<parent>\n<val/></parent>\n" +
+		"<mapsym>\n<symbol name=\"DAT_00401000\" typelock=\"true\" namelock=\"true\" cat=\"-1\">\n" +
+		"<type name=\"undefined8\" metatype=\"unknown\" size=\"8\" id=\"0x7000000000000001\"/>\n" +
+		"</symbol>\n<addr space=\"ram\" offset=\"0x401000\"/>\n<rangelist/>\n</mapsym>\n" +
+		"<mapsym>\n<symbol name=\"DAT_00401008\" typelock=\"true\" namelock=\"true\" cat=\"-1\">\n" +
+		"<type name=\"undefined8\" metatype=\"unknown\" size=\"8\" id=\"0x7000000000000001\"/>\n" +
+		"</symbol>\n<addr space=\"ram\" offset=\"0x401008\"/>\n<rangelist/>\n</mapsym>\n" +
+		"</result>\n";
+
+	private static final String EDGE_XML = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" +
+		"<!-- comment --><a x='1' y=\"-5\" z=\"0x0\" w=\"007\" v=\"0X1f\" u=\"-0\" " +
+		"t=\"0xffffffffffffffff\" s=\"&lt;&amp;&quot;&apos;&gt;\">" +
+		"<![CDATA[a<b]]>tail<b> </b>&#65;&#x42; <c>\n</c>\n</a>";
+
+	private static final String DECOMPILE_XML = "<doc>\n<function name=\"main\">" +
+		"<addr space=\"ram\" offset=\"0xfffffffffffffff0\" size=\"-8\"/>" +
+		"<syntax color=\"0\"> </syntax><op opref=\"0x1a\">&lt;&lt;</op>" +
+		"<syntax color=\"0\"> </syntax></function>\n</doc>\n";
+
+	// The packed form of DECOMPILE_XML as written by the decompiler process
+	private static final byte[] DECOMPILE_PACKED = { 127, 1, 2, 33, -125, 100, 111, 99, 5, 16,
+		33, -127, 10, 2, 33, -120, 102, 117, 110, 99, 116, 105, 111, 110, 4, 33, -124, 110, 97, 109,
+		101, 16, 33, -124, 109, 97, 105, 110, 2, 33, -124, 97, 100, 100, 114, 4, 33, -123, 115, 112,
+		97, 99, 101, 16, 33, -125, 114, 97, 109, 4, 33, -122, 111, 102, 102, 115, 101, 116, 17, -16,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -113, 4, 33, -124, 115, 105, 122, 101, 19, -120, 3, 2,
+		33, -122, 115, 121, 110, 116, 97, 120, 4, 33, -123, 99, 111, 108, 111, 114, 18, -128, 5, 16,
+		33, -127, 32, 3, 2, 33, -126, 111, 112, 4, 33, -123, 111, 112, 114, 101, 102, 17, -102, 5,
+		16, 33, -126, 60, 60, 3, 2, 32, -118, 4, 32, -117, 18, -128, 5, 16, 32, -116, 3, 3, 5, 16,
+		32, -127, 3 };
+
+	private static void assertSameElements(XmlPullParser expected, XmlPullParser actual) {
+		while (expected.hasNext()) {
+			assertTrue(actual.hasNext());
+			XmlElement e = expected.next();
+			XmlElement a = actual.next();
+			assertEquals(e.getName(), a.getName());
+			assertEquals(e.isStart(), a.isStart());
+			assertEquals(e.isEnd(), a.isEnd());
+			assertEquals(e.getLevel(), a.getLevel());
+			assertEquals(e.getAttributes(), a.getAttributes());
+			assertEquals(e.getText(), a.getText());
+		}
+		assertFalse(actual.hasNext());
+	}
+
+	private static void checkRoundTrip(String xml) throws Exception {
+		byte[] packed = PackedXmlEncoder.encode(xml);
+		for (byte b : packed) {
+			assertNotEquals("packed message must not contain a zero byte", 0, b);
+		}
+		assertTrue(PackedXmlEncoder.isEncoded(packed, packed.length));
+		XmlPullParser expected = new NonThreadedXmlPullParserImpl(xml, "xml", null, false);
+		XmlPullParser actual = new PackedXmlPullParser(packed, packed.length, "packed");
+		assertSameElements(expected, actual);
+	}
+
+	@Test
+	public void testSymbolsRoundTrip() throws Exception {
+		checkRoundTrip(SYMBOLS_XML);
+		byte[] packed = PackedXmlEncoder.encode(SYMBOLS_XML);
+		assertTrue(packed.length < SYMBOLS_XML.length());
+	}
+
+	@Test
+	public void testEdgeCasesRoundTrip() throws Exception {
+		checkRoundTrip(EDGE_XML);
+	}
+
+	@Test
+	public void testDecompileResultRoundTrip() throws Exception {
+		checkRoundTrip(DECOMPILE_XML);
+	}
+
+	@Test
+	public void testDecodeDecompilerMessage() throws Exception {
+		assertArrayEquals(DECOMPILE_PACKED, PackedXmlEncoder.encode(DECOMPILE_XML));
+		ByteArrayInputStream input = new ByteArrayInputStream(DECOMPILE_PACKED);
+		assertTrue(PackedXmlPullParser.isPacked(input));
+		XmlPullParser expected = new NonThreadedXmlPullParserImpl(DECOMPILE_XML, "xml", null, false);
+		XmlPullParser actual = new PackedXmlPullParser(input, "packed");
+		assertSameElements(expected, actual);
+	}
+
+	@Test
+	public void testXmlIsNotPacked() throws Exception {
+		ByteArrayInputStream input = new ByteArrayInputStream(DECOMPILE_XML.getBytes());
+		assertFalse(PackedXmlPullParser.isPacked(input));
+		assertEquals('<', input.read());
+	}
+}
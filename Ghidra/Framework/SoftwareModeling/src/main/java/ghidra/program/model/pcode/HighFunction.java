@@ -15,6 +15,7 @@
  */
 package ghidra.program.model.pcode;
 
+import java.io.BufferedInputStream;
 import java.io.InputStream;
 import java.util.ArrayList;
 import java.util.List;
@@ -594,7 +595,8 @@ public class HighFunction extends PcodeSyntaxTree {
 	}
 
 	/**
-	 * Create XML parse tree from an input XML string
+	 * Create XML parse tree from an input XML string.  If the stream holds a document in
+	 * the packed encoding negotiated with the decompiler, it is decoded without an XML parse.
 	 *
 	 * TODO: this probably doesn't belong here.
 	 *
@@ -607,6 +609,12 @@ public class HighFunction extends PcodeSyntaxTree {
 	static public XmlPullParser stringTree(InputStream xml, ErrorHandler handler)
 			throws PcodeXMLException {
 		try {
+			if (!xml.markSupported()) {
+				xml = new BufferedInputStream(xml);
+			}
+			if (PackedXmlPullParser.isPacked(xml)) {
+				return new PackedXmlPullParser(xml, "Decompiler Result Parser");
+			}
 			XmlPullParser parser =
 					XmlPullParserFactory.create(xml, "Decompiler Result Parser", handler, false);
 			return parser;